@@ -1093,6 +1093,18 @@ extern "C" {
 #define GLFW_CONNECTED              0x00040001
 #define GLFW_DISCONNECTED           0x00040002
 
+/*! @defgroup joystick_events Joystick event types
+ *  @brief Joystick event types.
+ *
+ *  See [joystick input history](@ref joystick_history) for how these are used.
+ *
+ *  @ingroup input
+ *  @{ */
+#define GLFW_JOYSTICK_AXIS_EVENT    0x00041001
+#define GLFW_JOYSTICK_BUTTON_EVENT  0x00041002
+#define GLFW_JOYSTICK_HAT_EVENT     0x00041003
+/*! @} */
+
 /*! @addtogroup init
  *  @{ */
 /*! @brief Joystick hat buttons init hint.
@@ -1100,6 +1112,16 @@ extern "C" {
  *  Joystick hat buttons [init hint](@ref GLFW_JOYSTICK_HAT_BUTTONS).
  */
 #define GLFW_JOYSTICK_HAT_BUTTONS   0x00050001
+/*! @brief Joystick input history init hint.
+ *
+ *  Joystick input history [init hint](@ref GLFW_JOYSTICK_HISTORY_SIZE).
+ */
+#define GLFW_JOYSTICK_HISTORY_SIZE  0x00050002
+/*! @brief Joystick extended IDs init hint.
+ *
+ *  Joystick extended IDs [init hint](@ref GLFW_JOYSTICK_EXTENDED_IDS).
+ */
+#define GLFW_JOYSTICK_EXTENDED_IDS  0x00050003
 /*! @brief macOS specific init hint.
  *
  *  macOS specific [init hint](@ref GLFW_COCOA_CHDIR_RESOURCES_hint).
@@ -1110,10 +1132,38 @@ extern "C" {
  *  macOS specific [init hint](@ref GLFW_COCOA_MENUBAR_hint).
  */
 #define GLFW_COCOA_MENUBAR          0x00051002
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_XIM_hint).
+ */
+#define GLFW_X11_XIM                0x00052001
 /*! @} */
 
 #define GLFW_DONT_CARE              -1
 
+/*! @addtogroup window
+ *  @{ */
+/*! @brief Image pixel format hint.
+ *
+ *  Image pixel format [hint](@ref GLFW_IMAGE_FORMAT_hint).
+ */
+#define GLFW_IMAGE_FORMAT           0x00061001
+/*! @brief Non-premultiplied RGBA image pixels.
+ *
+ *  Image [pixel format](@ref GLFW_IMAGE_FORMAT_hint) with four 8-bit channels
+ *  per pixel in red, green, blue, alpha order and non-premultiplied alpha.
+ *  This is the default.
+ */
+#define GLFW_IMAGE_RGBA             0
+/*! @brief Premultiplied BGRA image pixels.
+ *
+ *  Image [pixel format](@ref GLFW_IMAGE_FORMAT_hint) with four 8-bit channels
+ *  per pixel in blue, green, red, alpha order and premultiplied alpha.  Where
+ *  this is what the platform expects, the pixels are used without conversion.
+ */
+#define GLFW_IMAGE_BGRA_PREMULTIPLIED 0x00060001
+/*! @} */
+
 
 /*************************************************************************
  * GLFW API types
@@ -1292,6 +1342,25 @@ typedef void (* GLFWwindowclosefun)(GLFWwindow*);
  */
 typedef void (* GLFWwindowrefreshfun)(GLFWwindow*);
 
+/*! @brief The function pointer type for window frame callbacks.
+ *
+ *  This is the function pointer type for window frame callbacks.  A window
+ *  frame callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window);
+ *  @endcode
+ *
+ *  @param[in] window The window that is ready for a new frame.
+ *
+ *  @sa @ref window_frame
+ *  @sa @ref glfwSetWindowFrameCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWwindowframefun)(GLFWwindow*);
+
 /*! @brief The function pointer type for window focus callbacks.
  *
  *  This is the function pointer type for window focus callbacks.  A window
@@ -1562,6 +1631,27 @@ typedef void (* GLFWcharfun)(GLFWwindow*,unsigned int);
  */
 typedef void (* GLFWcharmodsfun)(GLFWwindow*,unsigned int,int);
 
+/*! @brief The function pointer type for text input callbacks.
+ *
+ *  This is the function pointer type for text input callbacks.  A text input
+ *  callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, const char* text)
+ *  @endcode
+ *
+ *  @param[in] window The window that received the event.
+ *  @param[in] text The UTF-8 encoded text that was input.  This string is
+ *  only valid until the callback returns.
+ *
+ *  @sa @ref input_char
+ *  @sa @ref glfwSetTextCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWtextfun)(GLFWwindow*,const char*);
+
 /*! @brief The function pointer type for path drop callbacks.
  *
  *  This is the function pointer type for path drop callbacks.  A path drop
@@ -1586,6 +1676,82 @@ typedef void (* GLFWcharmodsfun)(GLFWwindow*,unsigned int,int);
  */
 typedef void (* GLFWdropfun)(GLFWwindow*,int,const char*[]);
 
+/*! @brief The function pointer type for path drop stream callbacks.
+ *
+ *  This is the function pointer type for path drop stream callbacks.  A path
+ *  drop stream callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, int path_count, const char* paths[], int last)
+ *  @endcode
+ *
+ *  @param[in] window The window that received the event.
+ *  @param[in] path_count The number of dropped paths in this chunk.  This may
+ *  be zero for the last chunk.
+ *  @param[in] paths The UTF-8 encoded file and/or directory path names.
+ *  @param[in] last `GLFW_TRUE` if this is the last chunk of the drop, or
+ *  `GLFW_FALSE` otherwise.
+ *
+ *  @pointer_lifetime The path array and its strings are valid until the
+ *  callback function returns.
+ *
+ *  @sa @ref path_drop
+ *  @sa @ref glfwSetDropStreamCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWdropstreamfun)(GLFWwindow*,int,const char*[],int);
+
+/*! @brief The function pointer type for clipboard request callbacks.
+ *
+ *  This is the function pointer type for clipboard request callbacks.
+ *  A clipboard request callback function has the following signature:
+ *  @code
+ *  void function_name(const char* string)
+ *  @endcode
+ *
+ *  @param[in] string The UTF-8 encoded contents of the clipboard, or `NULL` if
+ *  it was empty or could not be converted.
+ *
+ *  @pointer_lifetime The string is valid until the callback function returns.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwRequestClipboardString
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWclipboardfun)(const char*);
+
+/*! @brief The function pointer type for clipboard provider callbacks.
+ *
+ *  This is the function pointer type for clipboard provider callbacks.
+ *  A clipboard provider callback function has the following signature:
+ *  @code
+ *  const void* function_name(const char* type, size_t* size)
+ *  @endcode
+ *
+ *  @param[in] type The MIME type requested, which is one of the types
+ *  specified when the provider was set.
+ *  @param[out] size Where to store the size, in bytes, of the returned data.
+ *  @return The clipboard contents in the requested type, or `NULL` if they
+ *  cannot be provided.
+ *
+ *  @pointer_lifetime The type string is valid until the callback function
+ *  returns.  The returned data must remain valid until the GLFW function that
+ *  called the callback returns.  GLFW copies it if it is needed for longer.
+ *
+ *  @sa @ref clipboard_provider
+ *  @sa @ref glfwSetClipboardProvider
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef const void* (* GLFWclipboardproviderfun)(const char*,size_t*);
+
 /*! @brief The function pointer type for monitor configuration callbacks.
  *
  *  This is the function pointer type for monitor configuration callbacks.
@@ -1628,6 +1794,69 @@ typedef void (* GLFWmonitorfun)(GLFWmonitor*,int);
  */
 typedef void (* GLFWjoystickfun)(int,int);
 
+/*! @brief The function pointer type for joystick axis callbacks.
+ *
+ *  This is the function pointer type for joystick axis callbacks.  A joystick
+ *  axis callback function has the following signature:
+ *  @code
+ *  void function_name(int jid, int axis, float value)
+ *  @endcode
+ *
+ *  @param[in] jid The joystick whose axis changed.
+ *  @param[in] axis The index of the axis that changed.
+ *  @param[in] value The new position of the axis, between -1.0 and 1.0.
+ *
+ *  @sa @ref joystick_input_event
+ *  @sa @ref glfwSetJoystickAxisCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWjoystickaxisfun)(int,int,float);
+
+/*! @brief The function pointer type for joystick button callbacks.
+ *
+ *  This is the function pointer type for joystick button callbacks.
+ *  A joystick button callback function has the following signature:
+ *  @code
+ *  void function_name(int jid, int button, int action)
+ *  @endcode
+ *
+ *  @param[in] jid The joystick whose button changed.
+ *  @param[in] button The index of the button that was pressed or released.
+ *  @param[in] action One of `GLFW_PRESS` or `GLFW_RELEASE`.
+ *
+ *  @sa @ref joystick_input_event
+ *  @sa @ref glfwSetJoystickButtonCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWjoystickbuttonfun)(int,int,int);
+
+/*! @brief The function pointer type for joystick hat callbacks.
+ *
+ *  This is the function pointer type for joystick hat callbacks.  A joystick
+ *  hat callback function has the following signature:
+ *  @code
+ *  void function_name(int jid, int hat, int state)
+ *  @endcode
+ *
+ *  @param[in] jid The joystick whose hat changed.
+ *  @param[in] hat The index of the hat that changed.
+ *  @param[in] state The new [hat state](@ref hat_state) of the hat.
+ *
+ *  @sa @ref joystick_input_event
+ *  @sa @ref glfwSetJoystickHatCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWjoystickhatfun)(int,int,int);
+
 /*! @brief Video mode type.
  *
  *  This describes a single video mode.
@@ -1740,6 +1969,36 @@ typedef struct GLFWgamepadstate
     float axes[6];
 } GLFWgamepadstate;
 
+/*! @brief Joystick input event.
+ *
+ *  This describes a single recorded change of joystick state.
+ *
+ *  @sa @ref joystick_history
+ *  @sa @ref glfwGetJoystickHistory
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWjoystickevent
+{
+    /*! The time of the change, in seconds, in the same time base as @ref
+     *  glfwGetTime.
+     */
+    double time;
+    /*! One of `GLFW_JOYSTICK_AXIS_EVENT`, `GLFW_JOYSTICK_BUTTON_EVENT` or
+     *  `GLFW_JOYSTICK_HAT_EVENT`.
+     */
+    int type;
+    /*! The index of the axis, button or hat that changed.
+     */
+    int index;
+    /*! The new axis position, the new button state (`GLFW_PRESS` or
+     *  `GLFW_RELEASE`) or the new [hat state](@ref hat_state).
+     */
+    float value;
+} GLFWjoystickevent;
+
 
 /*************************************************************************
  * GLFW API functions
@@ -2522,6 +2781,34 @@ GLFWAPI void glfwWindowHint(int hint, int value);
  */
 GLFWAPI void glfwWindowHintString(int hint, const char* value);
 
+/*! @brief Sets the specified image hint to the desired value.
+ *
+ *  This function sets hints for the next calls to @ref glfwCreateCursor and
+ *  @ref glfwSetWindowIcon.  The hints, once set, retain their values until
+ *  changed by a call to this function or until the library is terminated.
+ *
+ *  The only image hint is [GLFW_IMAGE_FORMAT](@ref GLFW_IMAGE_FORMAT_hint),
+ *  which specifies the pixel format of the images passed to those functions.
+ *  It can be either @ref GLFW_IMAGE_RGBA, the default, or @ref
+ *  GLFW_IMAGE_BGRA_PREMULTIPLIED.
+ *
+ *  @param[in] hint The image hint to set.
+ *  @param[in] value The new value of the image hint.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref cursor_custom
+ *  @sa @ref window_icon
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwImageHint(int hint, int value);
+
 /*! @brief Creates a window and its associated context.
  *
  *  This function creates a window and its associated OpenGL or OpenGL ES
@@ -2782,6 +3069,9 @@ GLFWAPI void glfwSetWindowTitle(GLFWwindow* window, const char* title);
  *  The pixels are 32-bit, little-endian, non-premultiplied RGBA, i.e. eight
  *  bits per channel with the red channel first.  They are arranged canonically
  *  as packed sequential rows, starting from the top-left corner.
+ *  If the [GLFW_IMAGE_FORMAT](@ref GLFW_IMAGE_FORMAT_hint) hint is @ref
+ *  GLFW_IMAGE_BGRA_PREMULTIPLIED, the pixels instead have the blue channel
+ *  first and premultiplied alpha.
  *
  *  The desired image sizes varies depending on platform and system settings.
  *  The selected images will be rescaled as needed.  Good sizes include 16x16,
@@ -3198,6 +3488,41 @@ GLFWAPI float glfwGetWindowOpacity(GLFWwindow* window);
  */
 GLFWAPI void glfwSetWindowOpacity(GLFWwindow* window, float opacity);
 
+/*! @brief Sets the resolution of the framebuffer relative to the window.
+ *
+ *  This function sets the scale of the framebuffer of the specified window
+ *  relative to its default size, which is the window size multiplied by the
+ *  [content scale](@ref window_scale).  The window system scales the
+ *  framebuffer to fill the window, so a smaller framebuffer reduces the cost
+ *  of rendering without changing the size of the window.
+ *
+ *  The scale is a positive finite number no greater than one.  The initial
+ *  render scale for newly created windows is one.
+ *
+ *  The new size takes effect for the next frame and is reported by the
+ *  [framebuffer size callback](@ref window_fbsize).
+ *
+ *  @param[in] window The window whose render scale to set.
+ *  @param[in] scale The desired render scale of the specified window.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @wayland This function requires the `wp_viewporter` protocol.
+ *
+ *  @remark @win32 @x11 @macos The render scale is currently ignored and the
+ *  framebuffer always has its default size.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_fbsize
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwSetWindowRenderScale(GLFWwindow* window, float scale);
+
 /*! @brief Iconifies the specified window.
  *
  *  This function iconifies (minimizes) the specified window if it was
@@ -3735,6 +4060,96 @@ GLFWAPI GLFWwindowclosefun glfwSetWindowCloseCallback(GLFWwindow* window, GLFWwi
  */
 GLFWAPI GLFWwindowrefreshfun glfwSetWindowRefreshCallback(GLFWwindow* window, GLFWwindowrefreshfun callback);
 
+/*! @brief Sets the frame callback for the specified window.
+ *
+ *  This function sets the frame callback of the specified window, which is
+ *  called when the window system is ready for the window to draw a new frame.
+ *
+ *  The callback is called once after the window contents were last presented
+ *  with @ref glfwSwapBuffers, or once after it is set.  It is not called while
+ *  the window is hidden, minimized or otherwise not visible, so an application
+ *  that only draws when this callback is called uses no CPU or GPU time while
+ *  nothing of the window can be seen.  @ref glfwWaitEvents returns when the
+ *  callback has been called.
+ *
+ *  If the window is not drawn in response to this callback, it will not be
+ *  called again until the contents have been presented.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(GLFWwindow* window);
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWwindowframefun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @win32 @x11 @macos This callback is currently never called.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_frame
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI GLFWwindowframefun glfwSetWindowFrameCallback(GLFWwindow* window, GLFWwindowframefun callback);
+
+/*! @brief Retrieves when the latest frame of the window reached the display.
+ *
+ *  This function retrieves the time at which the most recently presented frame
+ *  of the specified window was shown, along with the refresh period of the
+ *  display and the display's frame counter at that time.
+ *
+ *  The time is in seconds in the same time base as @ref glfwGetTime.  The
+ *  refresh period is in seconds and is zero if the display has no fixed refresh
+ *  rate.  The sequence is the value of the display's vertical retrace counter
+ *  and is zero if the display does not have one.
+ *
+ *  Presentation is only reported after a frame has been presented with @ref
+ *  glfwSwapBuffers and the window system has reported that it was shown, so
+ *  the result lags behind the most recently swapped frame.  Frames that are
+ *  never shown, for example because they were replaced by a newer frame before
+ *  the next refresh, are not reported.
+ *
+ *  Any or all of the retrieval arguments may be `NULL`.  If no frame has been
+ *  reported yet or an [error](@ref error_handling) occurs, all non-`NULL`
+ *  retrieval arguments will be set to zero.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] time Where to store the time the frame was shown, or `NULL`.
+ *  @param[out] refresh Where to store the refresh period, or `NULL`.
+ *  @param[out] sequence Where to store the retrace counter, or `NULL`.
+ *  @return `GLFW_TRUE` if a presented frame has been reported, or `GLFW_FALSE`
+ *  otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @wayland Presentation is only reported if the compositor supports
+ *  the `wp_presentation` protocol and the window has an EGL context.  It is
+ *  only requested for frames swapped with @ref glfwSwapBuffers, so frames of
+ *  a Vulkan window surface presented with `vkQueuePresentKHR` are never
+ *  reported.
+ *
+ *  @remark @win32 @x11 @macos Presentation is currently never reported.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_presentation
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwGetWindowPresentationTime(GLFWwindow* window, double* time, double* refresh, uint64_t* sequence);
+
 /*! @brief Sets the focus callback for the specified window.
  *
  *  This function sets the focus callback of the specified window, which is
@@ -4323,6 +4738,86 @@ GLFWAPI int glfwGetKey(GLFWwindow* window, int key);
  */
 GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
 
+/*! @brief Retrieves the last reported state of all keyboard keys for the
+ *  specified window.
+ *
+ *  This function stores the last state reported for every keyboard key to the
+ *  specified window, as `GLFW_PRESS` or `GLFW_RELEASE`, in the specified array
+ *  indexed by [key token](@ref keys).  The array must have at least
+ *  `GLFW_KEY_LAST + 1` elements.  Elements for values that are not key tokens
+ *  are set to `GLFW_RELEASE`.
+ *
+ *  This is equivalent to calling @ref glfwGetKey for every key, including the
+ *  handling of the @ref GLFW_STICKY_KEYS input mode, but much faster when
+ *  querying many keys.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] state Where to store the state of each key.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_key
+ *  @sa @ref glfwGetKeyboardStateBits
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwGetKeyboardState(GLFWwindow* window, unsigned char* state);
+
+/*! @brief Retrieves the last reported state of all keyboard keys for the
+ *  specified window as a bitset.
+ *
+ *  This function is the same as @ref glfwGetKeyboardState except that it
+ *  stores the key states as a bitset, where bit `key % 8` of element `key / 8`
+ *  is set if the key is pressed.  The array must have at least
+ *  `(GLFW_KEY_LAST + 8) / 8` elements.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] bits Where to store the state of each key.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_key
+ *  @sa @ref glfwGetKeyboardState
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwGetKeyboardStateBits(GLFWwindow* window, unsigned char* bits);
+
+/*! @brief Retrieves the last reported state of all mouse buttons for the
+ *  specified window.
+ *
+ *  This function stores the last state reported for every mouse button to the
+ *  specified window, as `GLFW_PRESS` or `GLFW_RELEASE`, in the specified array
+ *  indexed by [mouse button](@ref buttons).  The array must have at least
+ *  `GLFW_MOUSE_BUTTON_LAST + 1` elements.
+ *
+ *  This is equivalent to calling @ref glfwGetMouseButton for every mouse
+ *  button, including the handling of the @ref GLFW_STICKY_MOUSE_BUTTONS input
+ *  mode.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] state Where to store the state of each mouse button.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_mouse_button
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwGetMouseState(GLFWwindow* window, unsigned char* state);
+
 /*! @brief Retrieves the position of the cursor relative to the content area of
  *  the window.
  *
@@ -4410,19 +4905,26 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* window, double xpos, double ypos);
  *  The pixels are 32-bit, little-endian, non-premultiplied RGBA, i.e. eight
  *  bits per channel with the red channel first.  They are arranged canonically
  *  as packed sequential rows, starting from the top-left corner.
+ *  If the [GLFW_IMAGE_FORMAT](@ref GLFW_IMAGE_FORMAT_hint) hint is @ref
+ *  GLFW_IMAGE_BGRA_PREMULTIPLIED, the pixels instead have the blue channel
+ *  first and premultiplied alpha.
  *
  *  The cursor hotspot is specified in pixels, relative to the upper-left corner
  *  of the cursor image.  Like all other coordinate systems in GLFW, the X-axis
  *  points to the right and the Y-axis points down.
  *
+ *  If a cursor with identical image contents and hotspot already exists, the
+ *  same handle is returned and the native cursor is shared.  Each successful
+ *  call must still be matched by a call to @ref glfwDestroyCursor.
+ *
  *  @param[in] image The desired cursor image.
  *  @param[in] xhot The desired x-coordinate, in pixels, of the cursor hotspot.
  *  @param[in] yhot The desired y-coordinate, in pixels, of the cursor hotspot.
  *  @return The handle of the created cursor, or `NULL` if an
  *  [error](@ref error_handling) occurred.
  *
- *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
- *  GLFW_PLATFORM_ERROR.
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
  *
  *  @pointer_lifetime The specified image data is copied before this function
  *  returns.
@@ -4444,6 +4946,10 @@ GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
  *  Returns a cursor with a [standard shape](@ref shapes), that can be set for
  *  a window with @ref glfwSetCursor.
  *
+ *  If a cursor with the same shape already exists, the same handle is returned.
+ *  Each successful call must still be matched by a call to @ref
+ *  glfwDestroyCursor.
+ *
  *  @param[in] shape One of the [standard shapes](@ref shapes).
  *  @return A new cursor ready to use or `NULL` if an
  *  [error](@ref error_handling) occurred.
@@ -4468,8 +4974,13 @@ GLFWAPI GLFWcursor* glfwCreateStandardCursor(int shape);
  *  glfwCreateCursor.  Any remaining cursors will be destroyed by @ref
  *  glfwTerminate.
  *
- *  If the specified cursor is current for any window, that window will be
- *  reverted to the default cursor.  This does not affect the cursor mode.
+ *  If the same handle was returned by several creation calls, the cursor is
+ *  only destroyed once each of them has been matched by a call to this
+ *  function.
+ *
+ *  If the specified cursor is current for any window when it is destroyed,
+ *  that window will be reverted to the default cursor.  This does not affect
+ *  the cursor mode.
  *
  *  @param[in] cursor The cursor object to destroy.
  *
@@ -4651,6 +5162,47 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* window, GLFWcharfun callback
  */
 GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* window, GLFWcharmodsfun callback);
 
+/*! @brief Sets the text input callback.
+ *
+ *  This function sets the text input callback of the specified window, which
+ *  is called when text is input.
+ *
+ *  The text input callback receives the same characters as the [character
+ *  callback](@ref glfwSetCharCallback), but as UTF-8 encoded strings of all
+ *  the characters produced by a single platform input event, such as a key
+ *  press or an input method commit.  This allows text fields to handle long
+ *  input method commits in a single operation.  It is called after the
+ *  character callback has been called for each character of the same text.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(GLFWwindow* window, const char* text)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWtextfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @wayland There is no input method support, so each key press
+ *  produces its own text event.  Compose sequences that result in more than
+ *  one character are not reported.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_char
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* window, GLFWtextfun callback);
+
 /*! @brief Sets the mouse button callback.
  *
  *  This function sets the mouse button callback of the specified window, which
@@ -4810,11 +5362,10 @@ GLFWAPI GLFWscrollfun glfwSetScrollCallback(GLFWwindow* window, GLFWscrollfun ca
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
  *
- *  @remark @wayland File drop is currently unimplemented.
- *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref path_drop
+ *  @sa @ref glfwSetDropStreamCallback
  *
  *  @since Added in version 3.1.
  *
@@ -4822,6 +5373,76 @@ GLFWAPI GLFWscrollfun glfwSetScrollCallback(GLFWwindow* window, GLFWscrollfun ca
  */
 GLFWAPI GLFWdropfun glfwSetDropCallback(GLFWwindow* window, GLFWdropfun callback);
 
+/*! @brief Sets the path drop stream callback.
+ *
+ *  This function sets the path drop stream callback of the specified window,
+ *  which is called with the paths dropped on the window in one or more
+ *  chunks.  Where the platform provides the paths as a single list, as on X11
+ *  and Wayland, each chunk is delivered as soon as it has been parsed, so
+ *  dropping a very large number of paths never requires all of them to be
+ *  converted at once.
+ *
+ *  The last chunk of each drop has the `last` parameter set to `GLFW_TRUE`.
+ *  While this callback is set, the [path drop callback](@ref
+ *  glfwSetDropCallback) is not called.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new path drop stream callback, or `NULL` to remove
+ *  the currently set callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(GLFWwindow* window, int path_count, const char* paths[], int last)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWdropstreamfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @win32 @macos All paths are delivered in a single chunk.
+ *
+ *  @remark @wayland The list is read while [processing events](@ref events)
+ *  and each chunk is delivered as soon as the paths it holds have arrived, so
+ *  chunks before the last may be of any size.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref path_drop
+ *  @sa @ref glfwSetDropCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWdropstreamfun glfwSetDropStreamCallback(GLFWwindow* window, GLFWdropstreamfun callback);
+
+/*! @brief Returns the number of joystick IDs in use.
+ *
+ *  This function returns the number of joystick IDs that may currently refer to
+ *  a present joystick.  All present joysticks have an ID below this number.
+ *
+ *  Unless the @ref GLFW_JOYSTICK_EXTENDED_IDS init hint is enabled, this is
+ *  always `GLFW_JOYSTICK_LAST + 1`.  With extended IDs, joysticks beyond the
+ *  first sixteen are given IDs above `GLFW_JOYSTICK_LAST` and this number grows
+ *  to cover the most joysticks that have been connected at the same time.
+ *
+ *  @return The number of joystick IDs in use, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_extended_ids
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetJoystickIDCount(void);
+
 /*! @brief Returns whether the specified joystick is present.
  *
  *  This function returns whether the specified joystick is present.
@@ -4977,6 +5598,45 @@ GLFWAPI const unsigned char* glfwGetJoystickButtons(int jid, int* count);
  */
 GLFWAPI const unsigned char* glfwGetJoystickHats(int jid, int* count);
 
+/*! @brief Retrieves the recorded input history of the specified joystick.
+ *
+ *  This function retrieves the changes of axes, buttons and hats of the
+ *  specified joystick recorded after the specified time, oldest first.  Each
+ *  change is timestamped by when it was reported by the device, where the
+ *  platform provides this, so input arriving faster than the application
+ *  polls can be integrated at its native rate.
+ *
+ *  Input history is only recorded if the @ref GLFW_JOYSTICK_HISTORY_SIZE init
+ *  hint was set to a non-zero value.  Each joystick then keeps that many of its
+ *  most recent changes.
+ *
+ *  If more changes were recorded after the specified time than fit in the
+ *  array, the oldest of them are skipped.
+ *
+ *  If the specified joystick is not present this function will return zero but
+ *  will not generate an error.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) to query.
+ *  @param[in] since The time, in seconds, after which to retrieve changes.
+ *  @param[out] events The array to store the changes in.
+ *  @param[in] capacity The number of elements in the array.
+ *  @return The number of changes stored in the array, or zero if the joystick
+ *  is not present, no history is being recorded or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_history
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetJoystickHistory(int jid, double since, GLFWjoystickevent* events, int capacity);
+
 /*! @brief Returns the name of the specified joystick.
  *
  *  This function returns the name, encoded as UTF-8, of the specified joystick.
@@ -5139,6 +5799,9 @@ GLFWAPI int glfwJoystickIsGamepad(int jid);
  *  called by joystick functions.  The function will then return whatever it
  *  returns if the joystick is not present.
  *
+ *  Joysticks that are already connected when joystick support is initialized
+ *  are not reported.  Use @ref glfwJoystickPresent to find them.
+ *
  *  @param[in] callback The new callback, or `NULL` to remove the currently set
  *  callback.
  *  @return The previously set callback, or `NULL` if no callback was set or the
@@ -5163,6 +5826,246 @@ GLFWAPI int glfwJoystickIsGamepad(int jid);
  */
 GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun callback);
 
+/*! @brief Sets the joystick axis callback.
+ *
+ *  This function sets the joystick axis callback, or removes the currently set
+ *  callback.  This is called when an axis of any connected joystick changes
+ *  position.
+ *
+ *  On Linux, joystick input is read while [processing events](@ref events)
+ *  whenever any joystick input callback is set, so @ref glfwWaitEvents will
+ *  return as soon as a joystick changes state.  On other platforms, joystick
+ *  input callbacks are called when the joystick is polled by the joystick
+ *  functions.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int jid, int axis, float value)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWjoystickaxisfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_input_event
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWjoystickaxisfun glfwSetJoystickAxisCallback(GLFWjoystickaxisfun callback);
+
+/*! @brief Sets the joystick button callback.
+ *
+ *  This function sets the joystick button callback, or removes the currently
+ *  set callback.  This is called when a button of any connected joystick is
+ *  pressed or released.
+ *
+ *  Hats are reported through the [hat callback](@ref glfwSetJoystickHatCallback)
+ *  only, regardless of the @ref GLFW_JOYSTICK_HAT_BUTTONS init hint.
+ *
+ *  See @ref glfwSetJoystickAxisCallback for when joystick input callbacks are
+ *  called.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int jid, int button, int action)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWjoystickbuttonfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_input_event
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWjoystickbuttonfun glfwSetJoystickButtonCallback(GLFWjoystickbuttonfun callback);
+
+/*! @brief Sets the joystick hat callback.
+ *
+ *  This function sets the joystick hat callback, or removes the currently set
+ *  callback.  This is called when a hat of any connected joystick changes
+ *  state.
+ *
+ *  See @ref glfwSetJoystickAxisCallback for when joystick input callbacks are
+ *  called.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int jid, int hat, int state)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWjoystickhatfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_input_event
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWjoystickhatfun glfwSetJoystickHatCallback(GLFWjoystickhatfun callback);
+
+/*! @brief Creates a virtual joystick.
+ *
+ *  This function creates a joystick that is not backed by any device, with
+ *  the specified name, GUID and number of axes, buttons and hats.  Its state is
+ *  set by the application with @ref glfwSetVirtualJoystickAxis, @ref
+ *  glfwSetVirtualJoystickButton and @ref glfwSetVirtualJoystickHat and is
+ *  otherwise reported exactly like that of a physical joystick, including any
+ *  gamepad mapping matching its GUID.
+ *
+ *  This is available on all platforms, including the null platform, and is
+ *  intended for testing joystick and gamepad handling without hardware.  It
+ *  does not fail if support for physical joysticks could not be initialized.
+ *
+ *  The [joystick callback](@ref joystick_event) is called with `GLFW_CONNECTED`
+ *  before this function returns.
+ *
+ *  @param[in] name The name of the joystick, encoded as UTF-8.
+ *  @param[in] guid The SDL compatible GUID of the joystick, as a hexadecimal
+ *  string of at most 32 characters.
+ *  @param[in] axisCount The number of axes of the joystick.
+ *  @param[in] buttonCount The number of buttons of the joystick.
+ *  @param[in] hatCount The number of hats of the joystick.
+ *  @return The ID of the created joystick, or `-1` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark If all joystick IDs are in use, this function emits @ref
+ *  GLFW_PLATFORM_ERROR.  See @ref GLFW_JOYSTICK_EXTENDED_IDS for how to allow
+ *  more than sixteen joysticks.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_virtual
+ *  @sa @ref glfwDestroyVirtualJoystick
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwCreateVirtualJoystick(const char* name, const char* guid, int axisCount, int buttonCount, int hatCount);
+
+/*! @brief Destroys the specified virtual joystick.
+ *
+ *  This function destroys the specified virtual joystick.  The [joystick
+ *  callback](@ref joystick_event) is called with `GLFW_DISCONNECTED` before
+ *  this function returns.
+ *
+ *  Virtual joysticks remaining when the library is terminated are destroyed
+ *  by @ref glfwTerminate.
+ *
+ *  @param[in] jid The virtual joystick to destroy.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_virtual
+ *  @sa @ref glfwCreateVirtualJoystick
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwDestroyVirtualJoystick(int jid);
+
+/*! @brief Sets the position of an axis of a virtual joystick.
+ *
+ *  This function sets the position of the specified axis of the specified
+ *  virtual joystick.  The position is clamped to the range -1.0 to 1.0.
+ *
+ *  @param[in] jid The virtual joystick to modify.
+ *  @param[in] axis The index of the axis.
+ *  @param[in] value The new position of the axis.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_virtual
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetVirtualJoystickAxis(int jid, int axis, float value);
+
+/*! @brief Sets the state of a button of a virtual joystick.
+ *
+ *  This function sets the state of the specified button of the specified
+ *  virtual joystick.
+ *
+ *  @param[in] jid The virtual joystick to modify.
+ *  @param[in] button The index of the button.
+ *  @param[in] action The new state of the button, `GLFW_PRESS` or
+ *  `GLFW_RELEASE`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_virtual
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetVirtualJoystickButton(int jid, int button, int action);
+
+/*! @brief Sets the state of a hat of a virtual joystick.
+ *
+ *  This function sets the state of the specified hat of the specified virtual
+ *  joystick.
+ *
+ *  @param[in] jid The virtual joystick to modify.
+ *  @param[in] hat The index of the hat.
+ *  @param[in] state The new [hat state](@ref hat_state).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_virtual
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetVirtualJoystickHat(int jid, int hat, int state);
+
 /*! @brief Adds the specified SDL_GameControllerDB gamepad mappings.
  *
  *  This function parses the specified ASCII encoded string and updates the
@@ -5320,6 +6223,96 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* window, const char* string);
  */
 GLFWAPI const char* glfwGetClipboardString(GLFWwindow* window);
 
+/*! @brief Requests the contents of the clipboard as a string.
+ *
+ *  This function starts retrieving the contents of the system clipboard and
+ *  returns immediately.  The specified callback is called with the contents
+ *  during a later call to @ref glfwPollEvents, @ref glfwWaitEvents or @ref
+ *  glfwWaitEventsTimeout, once they have been received.  Unlike @ref
+ *  glfwGetClipboardString, this never blocks waiting for the application that
+ *  owns the clipboard.
+ *
+ *  If the clipboard is empty or if its contents cannot be converted to
+ *  a UTF-8 encoded string, the callback receives `NULL`.
+ *
+ *  If the application that owns the clipboard does not finish sending the
+ *  contents within five seconds, the request is abandoned and the callback
+ *  receives `NULL`.  While a request is in progress, @ref glfwWaitEvents and
+ *  @ref glfwWaitEventsTimeout return by that deadline.
+ *
+ *  If a request is already in progress, it is abandoned without calling its
+ *  callback and a new request is started.  The callback may request the
+ *  clipboard again.
+ *
+ *  @param[in] callback The function to call with the contents of the
+ *  clipboard.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @win32 @macos The clipboard is read when this function is called,
+ *  but the callback is still only called during event processing.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwGetClipboardString
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwRequestClipboardString(GLFWclipboardfun callback);
+
+/*! @brief Sets a provider for the contents of the clipboard.
+ *
+ *  This function makes the application the owner of the system clipboard,
+ *  offering its contents in the specified MIME types without retrieving them.
+ *  The specified callback is called to retrieve the contents in a given type
+ *  only when another application, or this one, pastes them.  This avoids
+ *  converting and keeping a copy of contents that may never be pasted.
+ *
+ *  The provider replaces any contents set with @ref glfwSetClipboardString
+ *  or a previous call to this function, and is replaced by any later call to
+ *  either.  The callback is only called during event processing or by
+ *  @ref glfwGetClipboardString and @ref glfwRequestClipboardString.
+ *
+ *  Text should be offered as `text/plain;charset=utf-8`, which is the type
+ *  used for @ref glfwGetClipboardString when the application owns the
+ *  clipboard.
+ *
+ *  @param[in] callback The function providing the clipboard contents.
+ *  @param[in] count The number of MIME types in the array.  This must be
+ *  greater than zero.
+ *  @param[in] types The MIME types offered, in order of preference.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @pointer_lifetime The specified type strings are copied before this
+ *  function returns.
+ *
+ *  @remark @win32 @macos @osmesa The callback is called for
+ *  `text/plain;charset=utf-8` when this function is called, if that type is
+ *  offered, and the resulting text is set with @ref glfwSetClipboardString.
+ *  Other types are not offered.
+ *
+ *  @remark @x11 Each MIME type is offered as a selection target of the same
+ *  name.  `text/plain;charset=utf-8` is also offered as `UTF8_STRING` and
+ *  `STRING`.  If a clipboard manager is running, the callback may also be
+ *  called by @ref glfwTerminate to hand over the contents.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard_provider
+ *  @sa @ref glfwSetClipboardString
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetClipboardProvider(GLFWclipboardproviderfun callback, int count, const char** types);
+
 /*! @brief Returns the GLFW time.
  *
  *  This function returns the current GLFW time, in seconds.  Unless the time
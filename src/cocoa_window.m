@@ -732,14 +732,32 @@ static const NSRange kEmptyRange = { NSNotFound, 0 };
         characters = (NSString*) string;
 
     const NSUInteger length = [characters length];
+    unsigned int* codepoints = calloc(length, sizeof(unsigned int));
+    int count = 0;
+
     for (NSUInteger i = 0;  i < length;  i++)
     {
-        const unichar codepoint = [characters characterAtIndex:i];
-        if ((codepoint & 0xff00) == 0xf700)
+        const unichar character = [characters characterAtIndex:i];
+        if ((character & 0xff00) == 0xf700)
             continue;
 
-        _glfwInputChar(window, codepoint, mods, plain);
+        if (CFStringIsSurrogateHighCharacter(character) && i + 1 < length)
+        {
+            const unichar low = [characters characterAtIndex:i + 1];
+            if (CFStringIsSurrogateLowCharacter(low))
+            {
+                codepoints[count++] =
+                    CFStringGetLongCharacterForSurrogatePair(character, low);
+                i++;
+                continue;
+            }
+        }
+
+        codepoints[count++] = character;
     }
+
+    _glfwInputText(window, codepoints, count, mods, plain);
+    free(codepoints);
 }
 
 - (void)doCommandBySelector:(SEL)selector
@@ -1180,6 +1198,10 @@ void _glfwPlatformRequestWindowAttention(_GLFWwindow* window)
     } // autoreleasepool
 }
 
+void _glfwPlatformRequestWindowFrame(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformFocusWindow(_GLFWwindow* window)
 {
     @autoreleasepool {
@@ -1377,6 +1399,10 @@ void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity)
     } // autoreleasepool
 }
 
+void _glfwPlatformSetWindowRenderScale(_GLFWwindow* window, float scale)
+{
+}
+
 void _glfwPlatformSetRawMouseMotion(_GLFWwindow *window, GLFWbool enabled)
 {
 }
@@ -1386,6 +1412,10 @@ GLFWbool _glfwPlatformRawMouseMotionSupported(void)
     return GLFW_FALSE;
 }
 
+void _glfwPlatformUpdateTextInput(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformPollEvents(void)
 {
     @autoreleasepool {
@@ -1604,7 +1634,8 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
     if (rep == nil)
         return GLFW_FALSE;
 
-    memcpy([rep bitmapData], image->pixels, image->width * image->height * 4);
+    _glfwConvertImage(image, cursor->format, _GLFW_PIXELS_RGBA, GLFW_FALSE,
+                      [rep bitmapData]);
 
     native = [[NSImage alloc] initWithSize:NSMakeSize(image->width, image->height)];
     [native addRepresentation:rep];
@@ -1707,6 +1738,22 @@ const char* _glfwPlatformGetClipboardString(void)
     } // autoreleasepool
 }
 
+GLFWbool _glfwPlatformRequestClipboardString(void)
+{
+    // The pasteboard is read synchronously by shared code
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformCancelClipboardRequest(void)
+{
+}
+
+GLFWbool _glfwPlatformSetClipboardProvider(void)
+{
+    // The pasteboard text is set up front by shared code
+    return GLFW_FALSE;
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (_glfw.vk.KHR_surface && _glfw.vk.EXT_metal_surface)
@@ -230,6 +230,11 @@ static void swapBuffersEGL(_GLFWwindow* window)
         return;
     }
 
+#if defined(_GLFW_WAYLAND)
+    // Feedback applies to the next commit of the surface, made by the swap
+    _glfwRequestPresentationFeedbackWayland(window);
+#endif
+
     eglSwapBuffers(_glfw.egl.display, window->context.egl.surface);
 }
 
@@ -0,0 +1,165 @@
+//========================================================================
+// GLFW 3.3 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2006-2019 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+// Please use C89 style variable declarations in this file because VS 2010
+//========================================================================
+
+#include "internal.h"
+
+#include <string.h>
+
+
+// Divides the product of two 8-bit values by 255, rounding to nearest
+// This is exact for every such product and needs no division
+//
+static unsigned int divide255(unsigned int value)
+{
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+// Reverses the premultiplication of a color channel by alpha, rounding to
+// nearest
+//
+static unsigned int unpremultiply(unsigned int value, unsigned int alpha)
+{
+    if (alpha == 0)
+        return 0;
+
+    value = (value * 255 + alpha / 2) / alpha;
+    return value > 255 ? 255 : value;
+}
+
+// Reads the pixel at the specified source position as 8-bit channels
+//
+static void readPixel(const unsigned char* source,
+                      GLFWbool bgraPremultiplied,
+                      GLFWbool premultiply,
+                      unsigned int* r,
+                      unsigned int* g,
+                      unsigned int* b,
+                      unsigned int* a)
+{
+    *a = source[3];
+
+    if (bgraPremultiplied)
+    {
+        *r = source[2];
+        *g = source[1];
+        *b = source[0];
+
+        if (!premultiply)
+        {
+            *r = unpremultiply(*r, *a);
+            *g = unpremultiply(*g, *a);
+            *b = unpremultiply(*b, *a);
+        }
+    }
+    else
+    {
+        *r = source[0];
+        *g = source[1];
+        *b = source[2];
+
+        if (premultiply)
+        {
+            *r = divide255(*r * *a);
+            *g = divide255(*g * *a);
+            *b = divide255(*b * *a);
+        }
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Converts the pixels of the specified image from the specified image format to
+// the specified layout, with or without premultiplied alpha
+// The loops only branch on loop-invariant flags so compilers can vectorize them
+//
+void _glfwConvertImage(const GLFWimage* image,
+                       int format,
+                       int layout,
+                       GLFWbool premultiply,
+                       void* target)
+{
+    const GLFWbool bgraPremultiplied =
+        (format == GLFW_IMAGE_BGRA_PREMULTIPLIED);
+    const int count = image->width * image->height;
+    const unsigned char* source = image->pixels;
+    unsigned int r, g, b, a;
+    int i;
+
+    // Images already in the requested layout are copied as they are
+    if (bgraPremultiplied && premultiply && layout == _GLFW_PIXELS_BGRA)
+    {
+        memcpy(target, source, count * 4);
+        return;
+    }
+
+    if (!bgraPremultiplied && !premultiply && layout == _GLFW_PIXELS_RGBA)
+    {
+        memcpy(target, source, count * 4);
+        return;
+    }
+
+    if (layout == _GLFW_PIXELS_ARGB)
+    {
+        uint32_t* pixels = target;
+
+        for (i = 0;  i < count;  i++, source += 4)
+        {
+            readPixel(source, bgraPremultiplied, premultiply, &r, &g, &b, &a);
+            pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    else if (layout == _GLFW_PIXELS_ARGB_LONG)
+    {
+        unsigned long* pixels = target;
+
+        for (i = 0;  i < count;  i++, source += 4)
+        {
+            readPixel(source, bgraPremultiplied, premultiply, &r, &g, &b, &a);
+            pixels[i] = ((unsigned long) a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    else
+    {
+        unsigned char* pixels = target;
+        const int first = (layout == _GLFW_PIXELS_BGRA) ? 2 : 0;
+
+        for (i = 0;  i < count;  i++, source += 4, pixels += 4)
+        {
+            readPixel(source, bgraPremultiplied, premultiply, &r, &g, &b, &a);
+            pixels[first] = (unsigned char) r;
+            pixels[1] = (unsigned char) g;
+            pixels[2 - first] = (unsigned char) b;
+            pixels[3] = (unsigned char) a;
+        }
+    }
+}
+
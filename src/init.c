@@ -53,9 +53,14 @@ static GLFWerrorfun _glfwErrorCallback;
 static _GLFWinitconfig _glfwInitHints =
 {
     GLFW_TRUE,      // hat buttons
+    0,              // joystick history size
+    GLFW_FALSE,     // joystick extended IDs
     {
         GLFW_TRUE,  // macOS menu bar
         GLFW_TRUE   // macOS bundle chdir
+    },
+    {
+        GLFW_TRUE   // X11 input method
     }
 };
 
@@ -71,7 +76,11 @@ static void terminate(void)
         glfwDestroyWindow((GLFWwindow*) _glfw.windowListHead);
 
     while (_glfw.cursorListHead)
+    {
+        // Shared cursors are destroyed regardless of how many handles remain
+        _glfw.cursorListHead->refCount = 1;
         glfwDestroyCursor((GLFWcursor*) _glfw.cursorListHead);
+    }
 
     for (i = 0;  i < _glfw.monitorCount;  i++)
     {
@@ -89,9 +98,34 @@ static void terminate(void)
     _glfw.mappings = NULL;
     _glfw.mappingCount = 0;
 
+    free(_glfw.clipboardRequest.string);
+    memset(&_glfw.clipboardRequest, 0, sizeof(_glfw.clipboardRequest));
+
     _glfwTerminateVulkan();
+
+    for (i = 0;  i < _glfw.joystickCount;  i++)
+    {
+        _GLFWjoystick* js = _glfw.joysticks[i];
+        if (js->present && js->isVirtual)
+            _glfwFreeJoystick(js);
+    }
+
+    if (_glfw.joysticksInitialized)
+        _glfwPlatformTerminateJoysticks();
+
     _glfwPlatformTerminate();
 
+    // The clipboard provider may be called when the platform hands over the
+    // clipboard contents during termination
+    _glfwClearClipboardProvider();
+
+    for (i = 0;  i < _glfw.joystickCount;  i++)
+        free(_glfw.joysticks[i]);
+
+    free(_glfw.joysticks);
+    _glfw.joysticks = NULL;
+    _glfw.joystickCount = 0;
+
     _glfw.initialized = GLFW_FALSE;
 
     while (_glfw.errorListHead)
@@ -113,11 +147,128 @@ static void terminate(void)
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Encode a Unicode code point to a UTF-8 stream
+// Based on cutef8 by Jeff Bezanson (Public Domain)
+//
+size_t _glfwEncodeUTF8(char* s, unsigned int codepoint)
+{
+    size_t count = 0;
+
+    if (codepoint < 0x80)
+        s[count++] = (char) codepoint;
+    else if (codepoint < 0x800)
+    {
+        s[count++] = (codepoint >> 6) | 0xc0;
+        s[count++] = (codepoint & 0x3f) | 0x80;
+    }
+    else if (codepoint < 0x10000)
+    {
+        s[count++] = (codepoint >> 12) | 0xe0;
+        s[count++] = ((codepoint >> 6) & 0x3f) | 0x80;
+        s[count++] = (codepoint & 0x3f) | 0x80;
+    }
+    else if (codepoint < 0x110000)
+    {
+        s[count++] = (codepoint >> 18) | 0xf0;
+        s[count++] = ((codepoint >> 12) & 0x3f) | 0x80;
+        s[count++] = ((codepoint >> 6) & 0x3f) | 0x80;
+        s[count++] = (codepoint & 0x3f) | 0x80;
+    }
+
+    return count;
+}
+
+// Returns the value of a hexadecimal digit, or -1 if it is not one
+//
+static int hexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+
+    return -1;
+}
+
+// Splits off the next path of a text/uri-list and percent-decodes it in place,
+// advancing the text past it
+// Returns NULL once the list has no more paths
+//
+char* _glfwParseUriListPath(char** text)
+{
+    const char* prefix = "file://";
+    const size_t prefixLength = strlen(prefix);
+
+    for (;;)
+    {
+        char* line = *text + strspn(*text, "\r\n");
+        char* end;
+        char* source;
+        char* target;
+
+        if (*line == '\0')
+        {
+            *text = line;
+            return NULL;
+        }
+
+        end = line + strcspn(line, "\r\n");
+        *text = *end ? end + 1 : end;
+        *end = '\0';
+
+        if (line[0] == '#')
+            continue;
+
+        if (strncmp(line, prefix, prefixLength) == 0)
+        {
+            // TODO: Validate hostname
+            line = strchr(line + prefixLength, '/');
+            if (!line)
+                continue;
+        }
+
+        // The path is decoded over itself, copying whole runs between escapes
+        // as decoding never makes it longer
+        source = target = line;
+
+        while (source < end)
+        {
+            const char* escape = memchr(source, '%', end - source);
+            const size_t length = (escape ? escape : end) - source;
+            int high, low;
+
+            memmove(target, source, length);
+            source += length;
+            target += length;
+
+            if (source == end)
+                break;
+
+            high = end - source > 2 ? hexDigitValue(source[1]) : -1;
+            low = end - source > 2 ? hexDigitValue(source[2]) : -1;
+
+            if (high >= 0 && low >= 0)
+            {
+                *target++ = (char) ((high << 4) | low);
+                source += 3;
+            }
+            else
+                *target++ = *source++;
+        }
+
+        *target = '\0';
+        return line;
+    }
+}
+
 char* _glfw_strdup(const char* source)
 {
     const size_t length = strlen(source);
     char* result = calloc(length + 1, 1);
-    strcpy(result, source);
+    if (result)
+        strcpy(result, source);
     return result;
 }
 
@@ -281,12 +432,28 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_JOYSTICK_HAT_BUTTONS:
             _glfwInitHints.hatButtons = value;
             return;
+        case GLFW_JOYSTICK_HISTORY_SIZE:
+            if (value < 0)
+            {
+                _glfwInputError(GLFW_INVALID_VALUE,
+                                "Invalid joystick history size %i", value);
+                return;
+            }
+
+            _glfwInitHints.joystickHistorySize = value;
+            return;
+        case GLFW_JOYSTICK_EXTENDED_IDS:
+            _glfwInitHints.joystickExtendedIDs = value;
+            return;
         case GLFW_COCOA_CHDIR_RESOURCES:
             _glfwInitHints.ns.chdir = value;
             return;
         case GLFW_COCOA_MENUBAR:
             _glfwInitHints.ns.menubar = value;
             return;
+        case GLFW_X11_XIM:
+            _glfwInitHints.x11.xim = value;
+            return;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM,
@@ -38,11 +38,78 @@
 // Internal key state used for sticky keys
 #define _GLFW_STICK 3
 
+// Maximum number of paths per drop stream callback
+#define _GLFW_DROP_CHUNK_SIZE 256
+
+// Seconds to wait for the clipboard owner before abandoning a request
+#define _GLFW_CLIPBOARD_REQUEST_TIMEOUT 5
+
 // Internal constants for gamepad mapping source types
 #define _GLFW_JOYSTICK_AXIS     1
 #define _GLFW_JOYSTICK_BUTTON   2
 #define _GLFW_JOYSTICK_HATBIT   3
 
+// Adds the specified bytes to an FNV-1a hash
+//
+static uint32_t hashBytes(uint32_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = data;
+    size_t i;
+
+    for (i = 0;  i < size;  i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// Computes the content hash of a custom cursor
+//
+static uint32_t hashCursor(const GLFWimage* image, int format,
+                           int xhot, int yhot)
+{
+    uint32_t hash = 2166136261u;
+
+    hash = hashBytes(hash, &image->width, sizeof(image->width));
+    hash = hashBytes(hash, &image->height, sizeof(image->height));
+    hash = hashBytes(hash, &format, sizeof(format));
+    hash = hashBytes(hash, &xhot, sizeof(xhot));
+    hash = hashBytes(hash, &yhot, sizeof(yhot));
+    return hashBytes(hash, image->pixels, image->width * image->height * 4);
+}
+
+// Finds an existing custom cursor with identical contents
+//
+static _GLFWcursor* findCursor(const GLFWimage* image, int format,
+                               int xhot, int yhot, uint32_t hash)
+{
+    _GLFWcursor* cursor;
+
+    for (cursor = _glfw.cursorListHead;  cursor;  cursor = cursor->next)
+    {
+        if (cursor->shape ||
+            cursor->hash != hash ||
+            cursor->xhot != xhot ||
+            cursor->yhot != yhot ||
+            cursor->image.width != image->width ||
+            cursor->image.height != image->height ||
+            cursor->format != format)
+        {
+            continue;
+        }
+
+        if (memcmp(cursor->image.pixels, image->pixels,
+                   image->width * image->height * 4) == 0)
+        {
+            return cursor;
+        }
+    }
+
+    return NULL;
+}
+
 // Finds a mapping based on joystick GUID
 //
 static _GLFWmapping* findMapping(const char* guid)
@@ -110,6 +177,169 @@ static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
     return mapping;
 }
 
+// Returns the index in the input array of a gamepad mapping source
+//
+static int getInputIndex(const _GLFWjoystick* js, const _GLFWmapelement* e)
+{
+    if (e->type == _GLFW_JOYSTICK_AXIS)
+        return 1 + e->index;
+    else if (e->type == _GLFW_JOYSTICK_BUTTON)
+        return 1 + js->axisCount + e->index;
+    else if (e->type == _GLFW_JOYSTICK_HATBIT)
+    {
+        // The element is active when the hat has any of the bits of its mask
+        const int hat = e->index >> 4;
+        const int mask = e->index & 0xf;
+
+        return 1 + js->axisCount + js->buttonCount + hat * 16 + mask;
+    }
+
+    // Unmapped elements read the constant zero input
+    return 0;
+}
+
+// Compiles the mapping of the specified joystick into scale and offset
+// transforms of its inputs, so gamepad state can be evaluated without branching
+// on element type
+//
+static void compileMapping(_GLFWjoystick* js)
+{
+    int i;
+
+    if (!js->mapping)
+        return;
+
+    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+    {
+        const _GLFWmapelement* e = js->mapping->buttons + i;
+
+        js->gamepad.buttonInputs[i] = getInputIndex(js, e);
+
+        // The button is pressed when the transformed input is non-negative
+        if (e->type == _GLFW_JOYSTICK_AXIS)
+        {
+            // Axes with a negative offset or a positive scale and no offset
+            // press the button at or above the center, others at or below it
+            float sign = 1.f;
+            if (!(e->axisOffset < 0 || (e->axisOffset == 0 && e->axisScale > 0)))
+                sign = -1.f;
+
+            js->gamepad.buttonScales[i] = sign * e->axisScale;
+            js->gamepad.buttonOffsets[i] = sign * e->axisOffset;
+        }
+        else if (e->type == _GLFW_JOYSTICK_BUTTON ||
+                 e->type == _GLFW_JOYSTICK_HATBIT)
+        {
+            js->gamepad.buttonScales[i] = 1.f;
+            js->gamepad.buttonOffsets[i] = -0.5f;
+        }
+        else
+        {
+            js->gamepad.buttonScales[i] = 0.f;
+            js->gamepad.buttonOffsets[i] = -1.f;
+        }
+    }
+
+    for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+    {
+        const _GLFWmapelement* e = js->mapping->axes + i;
+
+        js->gamepad.axisInputs[i] = getInputIndex(js, e);
+
+        if (e->type == _GLFW_JOYSTICK_AXIS)
+        {
+            js->gamepad.axisScales[i] = e->axisScale;
+            js->gamepad.axisOffsets[i] = e->axisOffset;
+        }
+        else if (e->type == _GLFW_JOYSTICK_BUTTON ||
+                 e->type == _GLFW_JOYSTICK_HATBIT)
+        {
+            js->gamepad.axisScales[i] = 2.f;
+            js->gamepad.axisOffsets[i] = -1.f;
+        }
+        else
+        {
+            js->gamepad.axisScales[i] = 0.f;
+            js->gamepad.axisOffsets[i] = 0.f;
+        }
+    }
+}
+
+// Initializes the platform joystick API if it has not been already
+//
+// If this fails there are no physical joysticks, but virtual joysticks are
+// handled entirely by shared code and remain available
+//
+static void initJoysticks(void)
+{
+    if (_glfw.joysticksInitialized || _glfw.joysticksFailed)
+        return;
+
+    // The platform code frees anything it set up before failing
+    if (_glfwPlatformInitJoysticks())
+        _glfw.joysticksInitialized = GLFW_TRUE;
+    else
+        _glfw.joysticksFailed = GLFW_TRUE;
+}
+
+// Checks whether the specified joystick ID is valid
+//
+static GLFWbool isValidJoystickID(int jid)
+{
+    if (jid < 0)
+        return GLFW_FALSE;
+    if (jid > GLFW_JOYSTICK_LAST && !_glfw.hints.init.joystickExtendedIDs)
+        return GLFW_FALSE;
+
+    return GLFW_TRUE;
+}
+
+// Returns the joystick with the specified ID, or NULL if it is not present
+//
+static _GLFWjoystick* getPresentJoystick(int jid)
+{
+    if (jid < 0 || jid >= _glfw.joystickCount)
+        return NULL;
+    if (!_glfw.joysticks[jid]->present)
+        return NULL;
+
+    return _glfw.joysticks[jid];
+}
+
+// Polls the specified joystick unless it is virtual
+//
+static GLFWbool pollJoystick(_GLFWjoystick* js, int mode)
+{
+    if (js->isVirtual)
+        return GLFW_TRUE;
+
+    return _glfwPlatformPollJoystick(js, mode);
+}
+
+// Returns the virtual joystick with the specified ID, or NULL and emits an
+// error if there is no such joystick
+//
+static _GLFWjoystick* getVirtualJoystick(int jid)
+{
+    _GLFWjoystick* js;
+
+    if (!isValidJoystickID(jid))
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return NULL;
+    }
+
+    js = getPresentJoystick(jid);
+    if (!js || !js->isVirtual)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Joystick %i is not a virtual joystick", jid);
+        return NULL;
+    }
+
+    return js;
+}
+
 // Parses an SDL_GameControllerDB line and adds it to the mapping list
 //
 static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
@@ -251,6 +481,46 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
     return GLFW_TRUE;
 }
 
+// Appends a change of joystick state to its input history
+//
+static void recordJoystickEvent(_GLFWjoystick* js, int type, int index, float value)
+{
+    _GLFWjoystickevent* e;
+
+    if (!js->history.size)
+        return;
+
+    if (js->history.count < js->history.size)
+    {
+        e = js->history.events +
+            (js->history.first + js->history.count) % js->history.size;
+        js->history.count++;
+    }
+    else
+    {
+        // The history is full so overwrite the oldest event
+        e = js->history.events + js->history.first;
+        js->history.first = (js->history.first + 1) % js->history.size;
+    }
+
+    if (js->eventTime)
+        e->time = js->eventTime;
+    else
+        e->time = _glfwPlatformGetTimerValue();
+
+    e->type = type;
+    e->index = index;
+    e->value = value;
+}
+
+// Converts a timer value to seconds in the time base of glfwGetTime
+//
+static double timerValueToTime(uint64_t value)
+{
+    return (double) (int64_t) (value - _glfw.timer.offset) /
+        _glfwPlatformGetTimerFrequency();
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -291,20 +561,67 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
 //
 void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWbool plain)
 {
-    if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
-        return;
+    _glfwInputText(window, &codepoint, 1, mods, plain);
+}
+
+// Notifies shared code of the Unicode code points produced by a single input
+// event, such as an input method commit
+// The 'plain' parameter determines whether to emit regular character events
+//
+void _glfwInputText(_GLFWwindow* window,
+                    const unsigned int* codepoints, int count,
+                    int mods, GLFWbool plain)
+{
+    int i;
+    char buffer[256];
+    char* text = buffer;
+    size_t length = 0;
+    const GLFWbool encode = plain && window->callbacks.text;
 
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
-    if (window->callbacks.charmods)
-        window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+    // Each code point is at most four bytes of UTF-8
+    if (encode && (size_t) count * 4 + 1 > sizeof(buffer))
+    {
+        text = calloc((size_t) count * 4 + 1, 1);
+        if (!text)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        const unsigned int codepoint = codepoints[i];
+
+        if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
+            continue;
 
-    if (plain)
+        if (window->callbacks.charmods)
+            window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+
+        if (plain)
+        {
+            if (window->callbacks.character)
+                window->callbacks.character((GLFWwindow*) window, codepoint);
+
+            if (encode)
+                length += _glfwEncodeUTF8(text + length, codepoint);
+        }
+    }
+
+    if (length)
     {
-        if (window->callbacks.character)
-            window->callbacks.character((GLFWwindow*) window, codepoint);
+        text[length] = '\0';
+
+        if (window->callbacks.text)
+            window->callbacks.text((GLFWwindow*) window, text);
     }
+
+    if (text != buffer)
+        free(text);
 }
 
 // Notifies shared code of a scroll event
@@ -361,32 +678,142 @@ void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
 //
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** paths)
 {
-    if (window->callbacks.drop)
+    if (window->callbacks.dropStream)
+        window->callbacks.dropStream((GLFWwindow*) window, count, paths, GLFW_TRUE);
+    else if (window->callbacks.drop)
+        window->callbacks.drop((GLFWwindow*) window, count, paths);
+}
+
+// Notifies shared code of a text/uri-list dropped on a window
+// The list is decoded in place and only as far as the callbacks need it
+// The list may be passed in parts of whole lines while a drop stream callback
+// is set, with only the final part marked as last
+//
+void _glfwInputDropUriList(_GLFWwindow* window, char* text, GLFWbool last)
+{
+    char* path;
+
+    if (window->callbacks.dropStream)
+    {
+        // Paths are delivered in chunks as they are parsed, holding back each
+        // full chunk until it is known whether it is the last one
+        const char* paths[_GLFW_DROP_CHUNK_SIZE];
+        int count = 0;
+
+        while ((path = _glfwParseUriListPath(&text)))
+        {
+            if (count == _GLFW_DROP_CHUNK_SIZE)
+            {
+                window->callbacks.dropStream((GLFWwindow*) window,
+                                             count, paths, GLFW_FALSE);
+                count = 0;
+            }
+
+            paths[count++] = path;
+        }
+
+        if (count || last)
+        {
+            window->callbacks.dropStream((GLFWwindow*) window,
+                                         count, paths, last);
+        }
+    }
+    else if (window->callbacks.drop)
+    {
+        const char** paths = NULL;
+        int count = 0, capacity = 0;
+
+        while ((path = _glfwParseUriListPath(&text)))
+        {
+            if (count == capacity)
+            {
+                const char** grown;
+
+                capacity = capacity * 2 + 16;
+                grown = realloc(paths, capacity * sizeof(char*));
+                if (!grown)
+                {
+                    _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                    free(paths);
+                    return;
+                }
+
+                paths = grown;
+            }
+
+            paths[count++] = path;
+        }
+
         window->callbacks.drop((GLFWwindow*) window, count, paths);
+        free(paths);
+    }
+}
+
+// Notifies shared code of the result of a clipboard request
+//
+void _glfwInputClipboardString(const char* string)
+{
+    // The callback may start another request
+    const GLFWclipboardfun callback = _glfw.clipboardRequest.callback;
+    _glfw.clipboardRequest.callback = NULL;
+    _glfw.clipboardRequest.pending = GLFW_FALSE;
+
+    if (callback)
+        callback(string);
 }
 
 // Notifies shared code of a joystick connection or disconnection
 //
 void _glfwInputJoystick(_GLFWjoystick* js, int event)
 {
-    const int jid = (int) (js - _glfw.joysticks);
+    js->connected = (event == GLFW_CONNECTED);
+
+    // Joysticks found while joystick support is initialized were already
+    // connected and are not reported, as initialization may happen inside
+    // a callback setter
+    if (!_glfw.joysticksInitialized && !_glfw.joysticksFailed)
+        return;
 
     if (_glfw.callbacks.joystick)
-        _glfw.callbacks.joystick(jid, event);
+        _glfw.callbacks.joystick(js->jid, event);
 }
 
 // Notifies shared code of the new value of a joystick axis
 //
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value)
 {
+    if (js->axes[axis] == value)
+        return;
+
     js->axes[axis] = value;
+    js->inputs[1 + axis] = value;
+
+    if (!js->connected)
+        return;
+
+    recordJoystickEvent(js, GLFW_JOYSTICK_AXIS_EVENT, axis, value);
+
+    if (_glfw.callbacks.joystickAxis)
+        _glfw.callbacks.joystickAxis(js->jid, axis, value);
 }
 
 // Notifies shared code of the new value of a joystick button
 //
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value)
 {
+    if (js->buttons[button] == value)
+        return;
+
     js->buttons[button] = value;
+    js->inputs[1 + js->axisCount + button] = value;
+
+    if (!js->connected)
+        return;
+
+    recordJoystickEvent(js, GLFW_JOYSTICK_BUTTON_EVENT, button, value);
+
+    if (_glfw.callbacks.joystickButton)
+        _glfw.callbacks.joystickButton(js->jid, button, value);
 }
 
 // Notifies shared code of the new value of a joystick hat
@@ -394,13 +821,29 @@ void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value)
 void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value)
 {
     const int base = js->buttonCount + hat * 4;
+    float* masks = js->inputs + 1 + js->axisCount + js->buttonCount + hat * 16;
+    int mask;
+
+    if (js->hats[hat] == value)
+        return;
 
     js->buttons[base + 0] = (value & 0x01) ? GLFW_PRESS : GLFW_RELEASE;
     js->buttons[base + 1] = (value & 0x02) ? GLFW_PRESS : GLFW_RELEASE;
     js->buttons[base + 2] = (value & 0x04) ? GLFW_PRESS : GLFW_RELEASE;
     js->buttons[base + 3] = (value & 0x08) ? GLFW_PRESS : GLFW_RELEASE;
 
+    for (mask = 0;  mask < 16;  mask++)
+        masks[mask] = (value & mask) ? 1.f : 0.f;
+
     js->hats[hat] = value;
+
+    if (!js->connected)
+        return;
+
+    recordJoystickEvent(js, GLFW_JOYSTICK_HAT_EVENT, hat, value);
+
+    if (_glfw.callbacks.joystickHat)
+        _glfw.callbacks.joystickHat(js->jid, hat, value);
 }
 
 
@@ -419,27 +862,83 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
     int jid;
     _GLFWjoystick* js;
 
-    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    for (jid = 0;  jid < _glfw.joystickCount;  jid++)
     {
-        if (!_glfw.joysticks[jid].present)
+        if (!_glfw.joysticks[jid]->present)
             break;
     }
 
-    if (jid > GLFW_JOYSTICK_LAST)
-        return NULL;
+    if (jid == _glfw.joystickCount)
+    {
+        _GLFWjoystick** joysticks;
+
+        if (jid > GLFW_JOYSTICK_LAST && !_glfw.hints.init.joystickExtendedIDs)
+            return NULL;
+
+        // Joystick objects are never moved or freed before termination, as
+        // their IDs must remain stable
+        joysticks = realloc(_glfw.joysticks,
+                            sizeof(_GLFWjoystick*) * (_glfw.joystickCount + 1));
+        if (!joysticks)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return NULL;
+        }
+
+        _glfw.joysticks = joysticks;
 
-    js = _glfw.joysticks + jid;
+        js = calloc(1, sizeof(_GLFWjoystick));
+        if (!js)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return NULL;
+        }
+
+        _glfw.joysticks[jid] = js;
+        _glfw.joystickCount++;
+    }
+
+    js = _glfw.joysticks[jid];
+    js->jid         = jid;
     js->present     = GLFW_TRUE;
     js->name        = _glfw_strdup(name);
     js->axes        = calloc(axisCount, sizeof(float));
     js->buttons     = calloc(buttonCount + (size_t) hatCount * 4, 1);
     js->hats        = calloc(hatCount, 1);
+    js->inputs      = calloc(1 + axisCount + buttonCount + (size_t) hatCount * 16,
+                             sizeof(float));
     js->axisCount   = axisCount;
     js->buttonCount = buttonCount;
     js->hatCount    = hatCount;
 
+    // Zero-sized arrays may legitimately be NULL
+    if (!js->name || !js->inputs ||
+        (axisCount && !js->axes) ||
+        ((buttonCount || hatCount) && !js->buttons) ||
+        (hatCount && !js->hats))
+    {
+        // The slot is left unused for the next joystick
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        _glfwFreeJoystick(js);
+        return NULL;
+    }
+
+    if (_glfw.hints.init.joystickHistorySize)
+    {
+        js->history.size = _glfw.hints.init.joystickHistorySize;
+        js->history.events = calloc(js->history.size,
+                                    sizeof(_GLFWjoystickevent));
+        if (!js->history.events)
+        {
+            // The joystick remains usable, only without input history
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            js->history.size = 0;
+        }
+    }
+
     strncpy(js->guid, guid, sizeof(js->guid) - 1);
     js->mapping = findValidMapping(js);
+    compileMapping(js);
 
     return js;
 }
@@ -448,11 +947,16 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
 //
 void _glfwFreeJoystick(_GLFWjoystick* js)
 {
+    const int jid = js->jid;
+
     free(js->name);
     free(js->axes);
     free(js->buttons);
     free(js->hats);
+    free(js->inputs);
+    free(js->history.events);
     memset(js, 0, sizeof(_GLFWjoystick));
+    js->jid = jid;
 }
 
 // Center the cursor in the content area of the specified window
@@ -465,6 +969,86 @@ void _glfwCenterCursorInContentArea(_GLFWwindow* window)
     _glfwPlatformSetCursorPos(window, width / 2.0, height / 2.0);
 }
 
+// Delivers the result of a clipboard request retrieved by shared code, or
+// abandons a platform request whose deadline has passed
+//
+void _glfwPollClipboardRequest(void)
+{
+    char* string;
+
+    if (_glfw.clipboardRequest.pending &&
+        _glfwPlatformGetTimerValue() >= _glfw.clipboardRequest.deadline)
+    {
+        // The clipboard owner never finished sending the contents
+        _glfwPlatformCancelClipboardRequest();
+        _glfwInputClipboardString(NULL);
+        return;
+    }
+
+    if (!_glfw.clipboardRequest.ready)
+        return;
+
+    string = _glfw.clipboardRequest.string;
+    _glfw.clipboardRequest.string = NULL;
+    _glfw.clipboardRequest.ready = GLFW_FALSE;
+
+    _glfwInputClipboardString(string);
+    free(string);
+}
+
+// Returns the specified event wait timeout, shortened so that the wait ends
+// by the deadline of any pending clipboard request
+//
+double _glfwGetClipboardRequestTimeout(double timeout)
+{
+    uint64_t now;
+    double remaining;
+
+    if (!_glfw.clipboardRequest.pending)
+        return timeout;
+
+    now = _glfwPlatformGetTimerValue();
+    if (now >= _glfw.clipboardRequest.deadline)
+        return 0.0;
+
+    remaining = (double) (_glfw.clipboardRequest.deadline - now) /
+        _glfwPlatformGetTimerFrequency();
+    return remaining < timeout ? remaining : timeout;
+}
+
+// Retrieves the clipboard contents in the specified type from the provider
+//
+const void* _glfwProvideClipboardData(const char* type, size_t* size)
+{
+    int i;
+
+    *size = 0;
+
+    if (!_glfw.clipboardProvider.callback)
+        return NULL;
+
+    for (i = 0;  i < _glfw.clipboardProvider.typeCount;  i++)
+    {
+        if (strcmp(_glfw.clipboardProvider.types[i], type) == 0)
+            return _glfw.clipboardProvider.callback(type, size);
+    }
+
+    return NULL;
+}
+
+// Removes the clipboard provider, if any
+//
+void _glfwClearClipboardProvider(void)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.clipboardProvider.typeCount;  i++)
+        free(_glfw.clipboardProvider.types[i]);
+
+    free(_glfw.clipboardProvider.types);
+    memset(&_glfw.clipboardProvider, 0, sizeof(_glfw.clipboardProvider));
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
@@ -672,6 +1256,78 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* handle, int button)
     return (int) window->mouseButtons[button];
 }
 
+GLFWAPI void glfwGetKeyboardState(GLFWwindow* handle, unsigned char* state)
+{
+    int key;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(state != NULL);
+
+    memset(state, GLFW_RELEASE, GLFW_KEY_LAST + 1);
+
+    _GLFW_REQUIRE_INIT();
+
+    for (key = 0;  key <= GLFW_KEY_LAST;  key++)
+    {
+        if (window->keys[key] == _GLFW_STICK)
+        {
+            // Sticky mode: release key now
+            window->keys[key] = GLFW_RELEASE;
+            state[key] = GLFW_PRESS;
+        }
+        else
+            state[key] = (unsigned char) window->keys[key];
+    }
+}
+
+GLFWAPI void glfwGetKeyboardStateBits(GLFWwindow* handle, unsigned char* bits)
+{
+    int key;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(bits != NULL);
+
+    memset(bits, 0, (GLFW_KEY_LAST + 8) / 8);
+
+    _GLFW_REQUIRE_INIT();
+
+    for (key = 0;  key <= GLFW_KEY_LAST;  key++)
+    {
+        if (window->keys[key] == GLFW_RELEASE)
+            continue;
+
+        // Sticky mode: release key now
+        if (window->keys[key] == _GLFW_STICK)
+            window->keys[key] = GLFW_RELEASE;
+
+        bits[key / 8] |= (unsigned char) (1 << (key % 8));
+    }
+}
+
+GLFWAPI void glfwGetMouseState(GLFWwindow* handle, unsigned char* state)
+{
+    int button;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(state != NULL);
+
+    memset(state, GLFW_RELEASE, GLFW_MOUSE_BUTTON_LAST + 1);
+
+    _GLFW_REQUIRE_INIT();
+
+    for (button = 0;  button <= GLFW_MOUSE_BUTTON_LAST;  button++)
+    {
+        if (window->mouseButtons[button] == _GLFW_STICK)
+        {
+            // Sticky mode: release mouse button now
+            window->mouseButtons[button] = GLFW_RELEASE;
+            state[button] = GLFW_PRESS;
+        }
+        else
+            state[button] = (unsigned char) window->mouseButtons[button];
+    }
+}
+
 GLFWAPI void glfwGetCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -730,13 +1386,27 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* handle, double xpos, double ypos)
 GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
 {
     _GLFWcursor* cursor;
+    uint32_t hash;
+    size_t size;
 
     assert(image != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
+    // Identical cursors share the native cursor instead of converting and
+    // uploading the image again
+    hash = hashCursor(image, _glfw.hints.imageFormat, xhot, yhot);
+    cursor = findCursor(image, _glfw.hints.imageFormat, xhot, yhot, hash);
+    if (cursor)
+    {
+        cursor->refCount++;
+        return (GLFWcursor*) cursor;
+    }
+
     cursor = calloc(1, sizeof(_GLFWcursor));
     cursor->next = _glfw.cursorListHead;
+    cursor->refCount = 1;
+    cursor->format = _glfw.hints.imageFormat;
     _glfw.cursorListHead = cursor;
 
     if (!_glfwPlatformCreateCursor(cursor, image, xhot, yhot))
@@ -745,6 +1415,21 @@ GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
         return NULL;
     }
 
+    size = image->width * image->height * 4;
+    cursor->image = *image;
+    cursor->image.pixels = malloc(size);
+    if (!cursor->image.pixels)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        glfwDestroyCursor((GLFWcursor*) cursor);
+        return NULL;
+    }
+
+    memcpy(cursor->image.pixels, image->pixels, size);
+    cursor->xhot = xhot;
+    cursor->yhot = yhot;
+    cursor->hash = hash;
+
     return (GLFWcursor*) cursor;
 }
 
@@ -765,8 +1450,19 @@ GLFWAPI GLFWcursor* glfwCreateStandardCursor(int shape)
         return NULL;
     }
 
+    // Each standard shape is only loaded from the cursor theme once
+    for (cursor = _glfw.cursorListHead;  cursor;  cursor = cursor->next)
+    {
+        if (cursor->shape == shape)
+        {
+            cursor->refCount++;
+            return (GLFWcursor*) cursor;
+        }
+    }
+
     cursor = calloc(1, sizeof(_GLFWcursor));
     cursor->next = _glfw.cursorListHead;
+    cursor->refCount = 1;
     _glfw.cursorListHead = cursor;
 
     if (!_glfwPlatformCreateStandardCursor(cursor, shape))
@@ -775,6 +1471,7 @@ GLFWAPI GLFWcursor* glfwCreateStandardCursor(int shape)
         return NULL;
     }
 
+    cursor->shape = shape;
     return (GLFWcursor*) cursor;
 }
 
@@ -787,6 +1484,10 @@ GLFWAPI void glfwDestroyCursor(GLFWcursor* handle)
     if (cursor == NULL)
         return;
 
+    // The cursor may have been returned by more than one creation call
+    if (--cursor->refCount > 0)
+        return;
+
     // Make sure the cursor is not being used by any window
     {
         _GLFWwindow* window;
@@ -810,6 +1511,7 @@ GLFWAPI void glfwDestroyCursor(GLFWcursor* handle)
         *prev = cursor->next;
     }
 
+    free(cursor->image.pixels);
     free(cursor);
 }
 
@@ -843,6 +1545,7 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* handle, GLFWcharfun cbfun)
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
     _GLFW_SWAP_POINTERS(window->callbacks.character, cbfun);
+    _glfwPlatformUpdateTextInput(window);
     return cbfun;
 }
 
@@ -853,6 +1556,18 @@ GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* handle, GLFWcharmods
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
     _GLFW_SWAP_POINTERS(window->callbacks.charmods, cbfun);
+    _glfwPlatformUpdateTextInput(window);
+    return cbfun;
+}
+
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* handle, GLFWtextfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.text, cbfun);
+    _glfwPlatformUpdateTextInput(window);
     return cbfun;
 }
 
@@ -910,26 +1625,50 @@ GLFWAPI GLFWdropfun glfwSetDropCallback(GLFWwindow* handle, GLFWdropfun cbfun)
     return cbfun;
 }
 
+GLFWAPI GLFWdropstreamfun glfwSetDropStreamCallback(GLFWwindow* handle,
+                                                    GLFWdropstreamfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.dropStream, cbfun);
+    return cbfun;
+}
+
+GLFWAPI int glfwGetJoystickIDCount(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    initJoysticks();
+
+    if (_glfw.joystickCount > GLFW_JOYSTICK_LAST + 1)
+        return _glfw.joystickCount;
+
+    return GLFW_JOYSTICK_LAST + 1;
+}
+
 GLFWAPI int glfwJoystickPresent(int jid)
 {
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return GLFW_FALSE;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return GLFW_FALSE;
 
-    return _glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE);
+    return pollJoystick(js, _GLFW_POLL_PRESENCE);
 }
 
 GLFWAPI const float* glfwGetJoystickAxes(int jid, int* count)
@@ -937,24 +1676,25 @@ GLFWAPI const float* glfwGetJoystickAxes(int jid, int* count)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
     assert(count != NULL);
 
     *count = 0;
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return NULL;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_AXES))
+    if (!pollJoystick(js, _GLFW_POLL_AXES))
         return NULL;
 
     *count = js->axisCount;
@@ -966,24 +1706,25 @@ GLFWAPI const unsigned char* glfwGetJoystickButtons(int jid, int* count)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
     assert(count != NULL);
 
     *count = 0;
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return NULL;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_BUTTONS))
+    if (!pollJoystick(js, _GLFW_POLL_BUTTONS))
         return NULL;
 
     if (_glfw.hints.init.hatButtons)
@@ -999,50 +1740,120 @@ GLFWAPI const unsigned char* glfwGetJoystickHats(int jid, int* count)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
     assert(count != NULL);
 
     *count = 0;
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return NULL;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_BUTTONS))
+    if (!pollJoystick(js, _GLFW_POLL_BUTTONS))
         return NULL;
 
     *count = js->hatCount;
     return js->hats;
 }
 
+GLFWAPI int glfwGetJoystickHistory(int jid, double since,
+                                   GLFWjoystickevent* events, int capacity)
+{
+    int i, start, end;
+    _GLFWjoystick* js;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(events != NULL);
+    assert(capacity >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (!isValidJoystickID(jid))
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return 0;
+    }
+
+    if (capacity < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid capacity %i", capacity);
+        return 0;
+    }
+
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
+        return 0;
+
+    if (!pollJoystick(js, _GLFW_POLL_ALL))
+        return 0;
+
+    // Events are recorded in time order, so find the first one after the
+    // specified time with a binary search
+    start = 0;
+    end = js->history.count;
+
+    while (start < end)
+    {
+        const int middle = start + (end - start) / 2;
+        const _GLFWjoystickevent* e = js->history.events +
+            (js->history.first + middle) % js->history.size;
+
+        if (timerValueToTime(e->time) > since)
+            end = middle;
+        else
+            start = middle + 1;
+    }
+
+    if (js->history.count - start > capacity)
+        start = js->history.count - capacity;
+
+    for (i = start;  i < js->history.count;  i++)
+    {
+        const _GLFWjoystickevent* e = js->history.events +
+            (js->history.first + i) % js->history.size;
+        GLFWjoystickevent* event = events + i - start;
+
+        event->time = timerValueToTime(e->time);
+        event->type = e->type;
+        event->index = e->index;
+        event->value = e->value;
+    }
+
+    return js->history.count - start;
+}
+
 GLFWAPI const char* glfwGetJoystickName(int jid)
 {
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return NULL;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     return js->name;
@@ -1053,21 +1864,22 @@ GLFWAPI const char* glfwGetJoystickGUID(int jid)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return NULL;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     return js->guid;
@@ -1078,12 +1890,13 @@ GLFWAPI void glfwSetJoystickUserPointer(int jid, void* pointer)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
 
     _GLFW_REQUIRE_INIT();
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return;
 
     js->userPointer = pointer;
@@ -1094,12 +1907,13 @@ GLFWAPI void* glfwGetJoystickUserPointer(int jid)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return NULL;
 
     return js->userPointer;
@@ -1109,9 +1923,185 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun cbfun)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
     _GLFW_SWAP_POINTERS(_glfw.callbacks.joystick, cbfun);
+
+    initJoysticks();
+    return cbfun;
+}
+
+GLFWAPI GLFWjoystickaxisfun glfwSetJoystickAxisCallback(GLFWjoystickaxisfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(_glfw.callbacks.joystickAxis, cbfun);
+
+    initJoysticks();
+    return cbfun;
+}
+
+GLFWAPI GLFWjoystickbuttonfun glfwSetJoystickButtonCallback(GLFWjoystickbuttonfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(_glfw.callbacks.joystickButton, cbfun);
+
+    initJoysticks();
+    return cbfun;
+}
+
+GLFWAPI GLFWjoystickhatfun glfwSetJoystickHatCallback(GLFWjoystickhatfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(_glfw.callbacks.joystickHat, cbfun);
+
+    initJoysticks();
     return cbfun;
 }
 
+GLFWAPI int glfwCreateVirtualJoystick(const char* name, const char* guid,
+                                      int axisCount, int buttonCount,
+                                      int hatCount)
+{
+    _GLFWjoystick* js;
+
+    assert(name != NULL);
+    assert(guid != NULL);
+    assert(axisCount >= 0);
+    assert(buttonCount >= 0);
+    assert(hatCount >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(-1);
+
+    if (axisCount < 0 || buttonCount < 0 || hatCount < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid joystick element count %i, %i, %i",
+                        axisCount, buttonCount, hatCount);
+        return -1;
+    }
+
+    if (strlen(guid) >= sizeof(js->guid))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid joystick GUID %s", guid);
+        return -1;
+    }
+
+    // Initialize first so physical joysticks keep their usual IDs
+    initJoysticks();
+
+    js = _glfwAllocJoystick(name, guid, axisCount, buttonCount, hatCount);
+    if (!js)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR, "No free joystick ID available");
+        return -1;
+    }
+
+    js->isVirtual = GLFW_TRUE;
+
+    _glfwInputJoystick(js, GLFW_CONNECTED);
+    return js->jid;
+}
+
+GLFWAPI void glfwDestroyVirtualJoystick(int jid)
+{
+    _GLFWjoystick* js;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+
+    _GLFW_REQUIRE_INIT();
+
+    js = getVirtualJoystick(jid);
+    if (!js)
+        return;
+
+    _glfwFreeJoystick(js);
+    _glfwInputJoystick(js, GLFW_DISCONNECTED);
+}
+
+GLFWAPI void glfwSetVirtualJoystickAxis(int jid, int axis, float value)
+{
+    _GLFWjoystick* js;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(axis >= 0);
+
+    _GLFW_REQUIRE_INIT();
+
+    js = getVirtualJoystick(jid);
+    if (!js)
+        return;
+
+    if (axis < 0 || axis >= js->axisCount)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid axis %i", axis);
+        return;
+    }
+
+    if (value != value)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid axis value");
+        return;
+    }
+
+    _glfwInputJoystickAxis(js, axis, _glfw_fminf(_glfw_fmaxf(value, -1.f), 1.f));
+}
+
+GLFWAPI void glfwSetVirtualJoystickButton(int jid, int button, int action)
+{
+    _GLFWjoystick* js;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(button >= 0);
+    assert(action == GLFW_PRESS || action == GLFW_RELEASE);
+
+    _GLFW_REQUIRE_INIT();
+
+    js = getVirtualJoystick(jid);
+    if (!js)
+        return;
+
+    if (button < 0 || button >= js->buttonCount)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid button %i", button);
+        return;
+    }
+
+    if (action != GLFW_PRESS && action != GLFW_RELEASE)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid button action 0x%08X", action);
+        return;
+    }
+
+    _glfwInputJoystickButton(js, button, (char) action);
+}
+
+GLFWAPI void glfwSetVirtualJoystickHat(int jid, int hat, int state)
+{
+    _GLFWjoystick* js;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(hat >= 0);
+    assert((state & ~(GLFW_HAT_UP | GLFW_HAT_RIGHT |
+                      GLFW_HAT_DOWN | GLFW_HAT_LEFT)) == 0);
+
+    _GLFW_REQUIRE_INIT();
+
+    js = getVirtualJoystick(jid);
+    if (!js)
+        return;
+
+    if (hat < 0 || hat >= js->hatCount)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid hat %i", hat);
+        return;
+    }
+
+    if (state & ~(GLFW_HAT_UP | GLFW_HAT_RIGHT | GLFW_HAT_DOWN | GLFW_HAT_LEFT))
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid hat state 0x%08X", state);
+        return;
+    }
+
+    _glfwInputJoystickHat(js, hat, (char) state);
+}
+
 GLFWAPI int glfwUpdateGamepadMappings(const char* string)
 {
     int jid;
@@ -1162,11 +2152,14 @@ GLFWAPI int glfwUpdateGamepadMappings(const char* string)
         }
     }
 
-    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    for (jid = 0;  jid < _glfw.joystickCount;  jid++)
     {
-        _GLFWjoystick* js = _glfw.joysticks + jid;
+        _GLFWjoystick* js = _glfw.joysticks[jid];
         if (js->present)
+        {
             js->mapping = findValidMapping(js);
+            compileMapping(js);
+        }
     }
 
     return GLFW_TRUE;
@@ -1177,21 +2170,22 @@ GLFWAPI int glfwJoystickIsGamepad(int jid)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return GLFW_FALSE;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return GLFW_FALSE;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return GLFW_FALSE;
 
     return js->mapping != NULL;
@@ -1202,21 +2196,22 @@ GLFWAPI const char* glfwGetGamepadName(int jid)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return NULL;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     if (!js->mapping)
@@ -1231,24 +2226,25 @@ GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
-    assert(jid <= GLFW_JOYSTICK_LAST);
     assert(state != NULL);
 
     memset(state, 0, sizeof(GLFWgamepadstate));
 
     _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
 
-    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    if (!isValidJoystickID(jid))
     {
         _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
         return GLFW_FALSE;
     }
 
-    js = _glfw.joysticks + jid;
-    if (!js->present)
+    initJoysticks();
+
+    js = getPresentJoystick(jid);
+    if (!js)
         return GLFW_FALSE;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_ALL))
+    if (!pollJoystick(js, _GLFW_POLL_ALL))
         return GLFW_FALSE;
 
     if (!js->mapping)
@@ -1256,53 +2252,18 @@ GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
 
     for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
     {
-        const _GLFWmapelement* e = js->mapping->buttons + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            // HACK: This should be baked into the value transform
-            // TODO: Bake into transform when implementing output modifiers
-            if (e->axisOffset < 0 || (e->axisOffset == 0 && e->axisScale > 0))
-            {
-                if (value >= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-            else
-            {
-                if (value <= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->buttons[i] = GLFW_PRESS;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->buttons[i] = js->buttons[e->index];
+        const float value =
+            js->inputs[js->gamepad.buttonInputs[i]] * js->gamepad.buttonScales[i] +
+            js->gamepad.buttonOffsets[i];
+        state->buttons[i] = (unsigned char) (value >= 0.f);
     }
 
     for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
     {
-        const _GLFWmapelement* e = js->mapping->axes + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            state->axes[i] = _glfw_fminf(_glfw_fmaxf(value, -1.f), 1.f);
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->axes[i] = 1.f;
-            else
-                state->axes[i] = -1.f;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->axes[i] = js->buttons[e->index] * 2.f - 1.f;
+        const float value =
+            js->inputs[js->gamepad.axisInputs[i]] * js->gamepad.axisScales[i] +
+            js->gamepad.axisOffsets[i];
+        state->axes[i] = _glfw_fminf(_glfw_fmaxf(value, -1.f), 1.f);
     }
 
     return GLFW_TRUE;
@@ -1313,6 +2274,8 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* handle, const char* string)
     assert(string != NULL);
 
     _GLFW_REQUIRE_INIT();
+
+    _glfwClearClipboardProvider();
     _glfwPlatformSetClipboardString(string);
 }
 
@@ -1322,6 +2285,112 @@ GLFWAPI const char* glfwGetClipboardString(GLFWwindow* handle)
     return _glfwPlatformGetClipboardString();
 }
 
+GLFWAPI void glfwRequestClipboardString(GLFWclipboardfun callback)
+{
+    const char* string;
+
+    assert(callback != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    // A new request replaces any request still in progress, as its owner may
+    // never finish sending the contents
+    if (_glfw.clipboardRequest.pending)
+    {
+        _glfwPlatformCancelClipboardRequest();
+        _glfw.clipboardRequest.pending = GLFW_FALSE;
+    }
+
+    free(_glfw.clipboardRequest.string);
+    _glfw.clipboardRequest.string = NULL;
+    _glfw.clipboardRequest.ready = GLFW_FALSE;
+
+    _glfw.clipboardRequest.callback = callback;
+
+    if (_glfwPlatformRequestClipboardString())
+    {
+        _glfw.clipboardRequest.pending = GLFW_TRUE;
+        _glfw.clipboardRequest.deadline = _glfwPlatformGetTimerValue() +
+            _GLFW_CLIPBOARD_REQUEST_TIMEOUT * _glfwPlatformGetTimerFrequency();
+        return;
+    }
+
+    // The platform cannot retrieve the clipboard asynchronously, so retrieve
+    // it now and deliver it during the next event processing
+    string = _glfwPlatformGetClipboardString();
+    if (string)
+        _glfw.clipboardRequest.string = _glfw_strdup(string);
+
+    _glfw.clipboardRequest.ready = GLFW_TRUE;
+    _glfwPlatformPostEmptyEvent();
+}
+
+GLFWAPI void glfwSetClipboardProvider(GLFWclipboardproviderfun callback,
+                                      int count, const char** types)
+{
+    int i;
+    size_t size;
+    const void* data;
+    char* string;
+
+    assert(callback != NULL);
+    assert(count > 0);
+    assert(types != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (count <= 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid MIME type count %i", count);
+        return;
+    }
+
+    _glfwClearClipboardProvider();
+
+    _glfw.clipboardProvider.types = calloc(count, sizeof(char*));
+    if (!_glfw.clipboardProvider.types)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return;
+    }
+
+    _glfw.clipboardProvider.typeCount = count;
+
+    for (i = 0;  i < count;  i++)
+    {
+        _glfw.clipboardProvider.types[i] = _glfw_strdup(types[i]);
+        if (!_glfw.clipboardProvider.types[i])
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            _glfwClearClipboardProvider();
+            return;
+        }
+    }
+
+    _glfw.clipboardProvider.callback = callback;
+
+    if (_glfwPlatformSetClipboardProvider())
+        return;
+
+    // The platform cannot provide the clipboard on demand, so set the text
+    // contents now, if they are offered
+    data = _glfwProvideClipboardData("text/plain;charset=utf-8", &size);
+    _glfwClearClipboardProvider();
+
+    string = calloc(size + 1, 1);
+    if (!string)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return;
+    }
+
+    if (data)
+        memcpy(string, data, size);
+
+    _glfwPlatformSetClipboardString(string);
+    free(string);
+}
+
 GLFWAPI double glfwGetTime(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(0.0);
@@ -58,6 +58,13 @@
 
 #define _GLFW_MESSAGE_SIZE      1024
 
+// Pixel layouts produced by _glfwConvertImage, where ARGB is a native-endian
+// 32-bit value per pixel and ARGB_LONG is the same value in an unsigned long
+#define _GLFW_PIXELS_RGBA       0
+#define _GLFW_PIXELS_BGRA       1
+#define _GLFW_PIXELS_ARGB       2
+#define _GLFW_PIXELS_ARGB_LONG  3
+
 typedef int GLFWbool;
 
 typedef struct _GLFWerror       _GLFWerror;
@@ -73,6 +80,7 @@ typedef struct _GLFWcursor      _GLFWcursor;
 typedef struct _GLFWmapelement  _GLFWmapelement;
 typedef struct _GLFWmapping     _GLFWmapping;
 typedef struct _GLFWjoystick    _GLFWjoystick;
+typedef struct _GLFWjoystickevent _GLFWjoystickevent;
 typedef struct _GLFWtls         _GLFWtls;
 typedef struct _GLFWmutex       _GLFWmutex;
 
@@ -240,10 +248,15 @@ struct _GLFWerror
 struct _GLFWinitconfig
 {
     GLFWbool      hatButtons;
+    int           joystickHistorySize;
+    GLFWbool      joystickExtendedIDs;
     struct {
         GLFWbool  menubar;
         GLFWbool  chdir;
     } ns;
+    struct {
+        GLFWbool  xim;
+    } x11;
 };
 
 // Window configuration
@@ -395,11 +408,20 @@ struct _GLFWwindow
 
     _GLFWcontext        context;
 
+    // Most recently presented frame, with the time as a timer value
+    struct {
+        GLFWbool        valid;
+        uint64_t        time;
+        double          refresh;
+        uint64_t        sequence;
+    } presentation;
+
     struct {
         GLFWwindowposfun        pos;
         GLFWwindowsizefun       size;
         GLFWwindowclosefun      close;
         GLFWwindowrefreshfun    refresh;
+        GLFWwindowframefun      frame;
         GLFWwindowfocusfun      focus;
         GLFWwindowiconifyfun    iconify;
         GLFWwindowmaximizefun   maximize;
@@ -412,7 +434,9 @@ struct _GLFWwindow
         GLFWkeyfun              key;
         GLFWcharfun             character;
         GLFWcharmodsfun         charmods;
+        GLFWtextfun             text;
         GLFWdropfun             drop;
+        GLFWdropstreamfun       dropStream;
     } callbacks;
 
     // This is defined in the window API's platform.h
@@ -448,6 +472,15 @@ struct _GLFWmonitor
 struct _GLFWcursor
 {
     _GLFWcursor*    next;
+    // Number of creation calls that returned this cursor and not yet destroyed
+    int             refCount;
+    // Standard cursor shape, or zero for a custom cursor
+    int             shape;
+    // Copy of the custom cursor image, used to find identical cursors
+    GLFWimage       image;
+    int             format;
+    int             xhot, yhot;
+    uint32_t        hash;
 
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_CURSOR_STATE;
@@ -473,11 +506,26 @@ struct _GLFWmapping
     _GLFWmapelement axes[6];
 };
 
+// Recorded joystick input event
+//
+struct _GLFWjoystickevent
+{
+    uint64_t        time;
+    int             type;
+    int             index;
+    float           value;
+};
+
 // Joystick structure
 //
 struct _GLFWjoystick
 {
+    int             jid;
     GLFWbool        present;
+    // Whether the joystick was created by glfwCreateVirtualJoystick
+    GLFWbool        isVirtual;
+    // Whether the application has been notified of the connection
+    GLFWbool        connected;
     float*          axes;
     int             axisCount;
     unsigned char*  buttons;
@@ -489,6 +537,29 @@ struct _GLFWjoystick
     char            guid[33];
     _GLFWmapping*   mapping;
 
+    // Constant zero followed by all axes and buttons as floats, then for each
+    // hat whether it has any of the bits of each of the 16 possible masks
+    float*          inputs;
+    // Current mapping compiled to scale and offset transforms of the inputs
+    struct {
+        int         buttonInputs[15];
+        float       buttonScales[15];
+        float       buttonOffsets[15];
+        int         axisInputs[6];
+        float       axisScales[6];
+        float       axisOffsets[6];
+    } gamepad;
+
+    // Timer value of the input being reported, or zero to use the current time
+    uint64_t        eventTime;
+
+    struct {
+        _GLFWjoystickevent* events;
+        int         size;
+        int         first;
+        int         count;
+    } history;
+
     // This is defined in the joystick API's joystick.h
     _GLFW_PLATFORM_JOYSTICK_STATE;
 };
@@ -521,6 +592,7 @@ struct _GLFWlibrary
         _GLFWwndconfig  window;
         _GLFWctxconfig  context;
         int             refreshRate;
+        int             imageFormat;
     } hints;
 
     _GLFWerror*         errorListHead;
@@ -530,10 +602,31 @@ struct _GLFWlibrary
     _GLFWmonitor**      monitors;
     int                 monitorCount;
 
-    _GLFWjoystick       joysticks[GLFW_JOYSTICK_LAST + 1];
+    GLFWbool            joysticksInitialized;
+    // The platform joystick API is not retried once it has failed
+    GLFWbool            joysticksFailed;
+    _GLFWjoystick**     joysticks;
+    int                 joystickCount;
     _GLFWmapping*       mappings;
     int                 mappingCount;
 
+    struct {
+        GLFWclipboardfun callback;
+        // Whether the platform is retrieving the contents asynchronously
+        GLFWbool        pending;
+        // Timer value after which a pending request is abandoned
+        uint64_t        deadline;
+        // Whether string holds a result retrieved by shared code
+        GLFWbool        ready;
+        char*           string;
+    } clipboardRequest;
+
+    struct {
+        GLFWclipboardproviderfun callback;
+        char**          types;
+        int             typeCount;
+    } clipboardProvider;
+
     _GLFWtls            errorSlot;
     _GLFWtls            contextSlot;
     _GLFWmutex          errorLock;
@@ -569,6 +662,9 @@ struct _GLFWlibrary
     struct {
         GLFWmonitorfun  monitor;
         GLFWjoystickfun joystick;
+        GLFWjoystickaxisfun joystickAxis;
+        GLFWjoystickbuttonfun joystickButton;
+        GLFWjoystickhatfun joystickHat;
     } callbacks;
 
     // This is defined in the window API's platform.h
@@ -601,6 +697,7 @@ void _glfwPlatformSetCursorPos(_GLFWwindow* window, double xpos, double ypos);
 void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode);
 void _glfwPlatformSetRawMouseMotion(_GLFWwindow *window, GLFWbool enabled);
 GLFWbool _glfwPlatformRawMouseMotionSupported(void);
+void _glfwPlatformUpdateTextInput(_GLFWwindow* window);
 int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
                               const GLFWimage* image, int xhot, int yhot);
 int _glfwPlatformCreateStandardCursor(_GLFWcursor* cursor, int shape);
@@ -622,7 +719,12 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 
 void _glfwPlatformSetClipboardString(const char* string);
 const char* _glfwPlatformGetClipboardString(void);
+GLFWbool _glfwPlatformRequestClipboardString(void);
+void _glfwPlatformCancelClipboardRequest(void);
+GLFWbool _glfwPlatformSetClipboardProvider(void);
 
+GLFWbool _glfwPlatformInitJoysticks(void);
+void _glfwPlatformTerminateJoysticks(void);
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode);
 void _glfwPlatformUpdateGamepadGUID(char* guid);
 
@@ -657,6 +759,7 @@ void _glfwPlatformMaximizeWindow(_GLFWwindow* window);
 void _glfwPlatformShowWindow(_GLFWwindow* window);
 void _glfwPlatformHideWindow(_GLFWwindow* window);
 void _glfwPlatformRequestWindowAttention(_GLFWwindow* window);
+void _glfwPlatformRequestWindowFrame(_GLFWwindow* window);
 void _glfwPlatformFocusWindow(_GLFWwindow* window);
 void _glfwPlatformSetWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor,
                                    int xpos, int ypos, int width, int height,
@@ -672,6 +775,7 @@ void _glfwPlatformSetWindowResizable(_GLFWwindow* window, GLFWbool enabled);
 void _glfwPlatformSetWindowDecorated(_GLFWwindow* window, GLFWbool enabled);
 void _glfwPlatformSetWindowFloating(_GLFWwindow* window, GLFWbool enabled);
 void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity);
+void _glfwPlatformSetWindowRenderScale(_GLFWwindow* window, float scale);
 
 void _glfwPlatformPollEvents(void);
 void _glfwPlatformWaitEvents(void);
@@ -711,6 +815,11 @@ void _glfwInputWindowContentScale(_GLFWwindow* window,
 void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified);
 void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized);
 void _glfwInputWindowDamage(_GLFWwindow* window);
+void _glfwInputWindowFrame(_GLFWwindow* window);
+void _glfwInputWindowPresentation(_GLFWwindow* window,
+                                  uint64_t time,
+                                  double refresh,
+                                  uint64_t sequence);
 void _glfwInputWindowCloseRequest(_GLFWwindow* window);
 void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor);
 
@@ -718,11 +827,16 @@ void _glfwInputKey(_GLFWwindow* window,
                    int key, int scancode, int action, int mods);
 void _glfwInputChar(_GLFWwindow* window,
                     unsigned int codepoint, int mods, GLFWbool plain);
+void _glfwInputText(_GLFWwindow* window,
+                    const unsigned int* codepoints, int count,
+                    int mods, GLFWbool plain);
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset);
 void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods);
 void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos);
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered);
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** names);
+void _glfwInputDropUriList(_GLFWwindow* window, char* text, GLFWbool last);
+void _glfwInputClipboardString(const char* string);
 void _glfwInputJoystick(_GLFWjoystick* js, int event);
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value);
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value);
@@ -767,11 +881,24 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   int hatCount);
 void _glfwFreeJoystick(_GLFWjoystick* js);
 void _glfwCenterCursorInContentArea(_GLFWwindow* window);
+void _glfwPollClipboardRequest(void);
+double _glfwGetClipboardRequestTimeout(double timeout);
+const void* _glfwProvideClipboardData(const char* type, size_t* size);
+void _glfwClearClipboardProvider(void);
 
 GLFWbool _glfwInitVulkan(int mode);
 void _glfwTerminateVulkan(void);
 const char* _glfwGetVulkanResultString(VkResult result);
 
+void _glfwConvertImage(const GLFWimage* image,
+                       int format,
+                       int layout,
+                       GLFWbool premultiply,
+                       void* target);
+
+size_t _glfwEncodeUTF8(char* s, unsigned int codepoint);
+char* _glfwParseUriListPath(char** text);
+
 char* _glfw_strdup(const char* source);
 float _glfw_fminf(float a, float b);
 float _glfw_fmaxf(float a, float b);
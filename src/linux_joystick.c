@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #ifndef SYN_DROPPED // < v2.6.39 kernel headers
@@ -45,20 +46,45 @@
 #define SYN_DROPPED 3
 #endif
 
+#ifndef input_event_sec // < v4.16 kernel headers
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
 // Apply an EV_KEY event to the specified joystick
 //
 static void handleKeyEvent(_GLFWjoystick* js, int code, int value)
 {
-    _glfwInputJoystickButton(js,
-                             js->linjs.keyMap[code - BTN_MISC],
-                             value ? GLFW_PRESS : GLFW_RELEASE);
+    int first = 0, last = js->buttonCount - 1;
+
+    // Find the button with a binary search of the sorted key codes
+    while (first <= last)
+    {
+        const int middle = first + (last - first) / 2;
+
+        if (js->linjs.keyCodes[middle] < code)
+            first = middle + 1;
+        else if (js->linjs.keyCodes[middle] > code)
+            last = middle - 1;
+        else
+        {
+            _glfwInputJoystickButton(js, middle,
+                                     value ? GLFW_PRESS : GLFW_RELEASE);
+            return;
+        }
+    }
 }
 
 // Apply an EV_ABS event to the specified joystick
 //
 static void handleAbsEvent(_GLFWjoystick* js, int code, int value)
 {
+    if (code < 0 || code >= ABS_CNT)
+        return;
+
     const int index = js->linjs.absMap[code];
+    if (index < 0)
+        return;
 
     if (code >= ABS_HAT0X && code <= ABS_HAT3Y)
     {
@@ -86,7 +112,7 @@ static void handleAbsEvent(_GLFWjoystick* js, int code, int value)
     }
     else
     {
-        const struct input_absinfo* info = &js->linjs.absInfo[code];
+        const struct input_absinfo* info = &js->linjs.absInfo[index];
         float normalized = value;
 
         const int range = info->maximum - info->minimum;
@@ -108,36 +134,42 @@ static void pollAbsState(_GLFWjoystick* js)
 {
     for (int code = 0;  code < ABS_CNT;  code++)
     {
-        if (js->linjs.absMap[code] < 0)
+        const int index = js->linjs.absMap[code];
+        if (index < 0)
             continue;
 
-        struct input_absinfo* info = &js->linjs.absInfo[code];
+        struct input_absinfo info;
 
-        if (ioctl(js->linjs.fd, EVIOCGABS(code), info) < 0)
+        if (ioctl(js->linjs.fd, EVIOCGABS(code), &info) < 0)
             continue;
 
-        handleAbsEvent(js, code, info->value);
+        if (code < ABS_HAT0X || code > ABS_HAT3Y)
+            js->linjs.absInfo[index] = info;
+
+        handleAbsEvent(js, code, info.value);
     }
 }
 
 #define isBitSet(bit, arr) (arr[(bit) / 8] & (1 << ((bit) % 8)))
 
 // Attempt to open the specified joystick device
+// The connection event is left to the caller
 //
-static GLFWbool openJoystickDevice(const char* path)
+static _GLFWjoystick* openJoystickDevice(const char* path)
 {
-    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    for (int jid = 0;  jid < _glfw.joystickCount;  jid++)
     {
-        if (!_glfw.joysticks[jid].present)
+        const _GLFWjoystick* js = _glfw.joysticks[jid];
+        if (!js->present || js->isVirtual)
             continue;
-        if (strcmp(_glfw.joysticks[jid].linjs.path, path) == 0)
-            return GLFW_FALSE;
+        if (strcmp(js->linjs.path, path) == 0)
+            return NULL;
     }
 
     _GLFWjoystickLinux linjs = {0};
     linjs.fd = open(path, O_RDONLY | O_NONBLOCK);
     if (linjs.fd == -1)
-        return GLFW_FALSE;
+        return NULL;
 
     char evBits[(EV_CNT + 7) / 8] = {0};
     char keyBits[(KEY_CNT + 7) / 8] = {0};
@@ -153,14 +185,30 @@ static GLFWbool openJoystickDevice(const char* path)
                         "Linux: Failed to query input device: %s",
                         strerror(errno));
         close(linjs.fd);
-        return GLFW_FALSE;
+        return NULL;
     }
 
     // Ensure this device supports the events expected of a joystick
     if (!isBitSet(EV_KEY, evBits) || !isBitSet(EV_ABS, evBits))
     {
         close(linjs.fd);
-        return GLFW_FALSE;
+        return NULL;
+    }
+
+    // Have the device timestamp its events with the clock used by the timer,
+    // so their times can be used for the joystick input history
+    if (_glfw.timer.posix.monotonic)
+    {
+#if defined(EVIOCSCLOCKID)
+        int clock = CLOCK_MONOTONIC;
+        if (ioctl(linjs.fd, EVIOCSCLOCKID, &clock) == 0)
+            linjs.timestamps = GLFW_TRUE;
+#endif
+    }
+    else
+    {
+        // Events are timestamped with the real time clock by default
+        linjs.timestamps = GLFW_TRUE;
     }
 
     char name[256] = "";
@@ -189,13 +237,15 @@ static GLFWbool openJoystickDevice(const char* path)
     }
 
     int axisCount = 0, buttonCount = 0, hatCount = 0;
+    unsigned short keyCodes[KEY_CNT - BTN_MISC];
+    struct input_absinfo absInfo[ABS_CNT];
 
     for (int code = BTN_MISC;  code < KEY_CNT;  code++)
     {
         if (!isBitSet(code, keyBits))
             continue;
 
-        linjs.keyMap[code - BTN_MISC] = buttonCount;
+        keyCodes[buttonCount] = code;
         buttonCount++;
     }
 
@@ -207,14 +257,16 @@ static GLFWbool openJoystickDevice(const char* path)
 
         if (code >= ABS_HAT0X && code <= ABS_HAT3Y)
         {
+            // Both axes of a hat map to the same hat
             linjs.absMap[code] = hatCount;
+            linjs.absMap[code + 1] = hatCount;
             hatCount++;
             // Skip the Y axis
             code++;
         }
         else
         {
-            if (ioctl(linjs.fd, EVIOCGABS(code), &linjs.absInfo[code]) < 0)
+            if (ioctl(linjs.fd, EVIOCGABS(code), &absInfo[axisCount]) < 0)
                 continue;
 
             linjs.absMap[code] = axisCount;
@@ -227,16 +279,20 @@ static GLFWbool openJoystickDevice(const char* path)
     if (!js)
     {
         close(linjs.fd);
-        return GLFW_FALSE;
+        return NULL;
     }
 
-    strncpy(linjs.path, path, sizeof(linjs.path) - 1);
+    // Only keep as much of the button and axis data as the device uses
+    linjs.path = _glfw_strdup(path);
+    linjs.keyCodes = calloc(buttonCount, sizeof(unsigned short));
+    memcpy(linjs.keyCodes, keyCodes, buttonCount * sizeof(unsigned short));
+    linjs.absInfo = calloc(axisCount, sizeof(struct input_absinfo));
+    memcpy(linjs.absInfo, absInfo, axisCount * sizeof(struct input_absinfo));
+
     memcpy(&js->linjs, &linjs, sizeof(linjs));
 
     pollAbsState(js);
-
-    _glfwInputJoystick(js, GLFW_CONNECTED);
-    return GLFW_TRUE;
+    return js;
 }
 
 #undef isBitSet
@@ -246,16 +302,28 @@ static GLFWbool openJoystickDevice(const char* path)
 static void closeJoystick(_GLFWjoystick* js)
 {
     close(js->linjs.fd);
+    free(js->linjs.path);
+    free(js->linjs.keyCodes);
+    free(js->linjs.absInfo);
     _glfwFreeJoystick(js);
     _glfwInputJoystick(js, GLFW_DISCONNECTED);
 }
 
+// Returns whether any joystick input callback is set
+//
+static GLFWbool hasInputCallbacks(void)
+{
+    return _glfw.callbacks.joystickAxis ||
+           _glfw.callbacks.joystickButton ||
+           _glfw.callbacks.joystickHat;
+}
+
 // Lexically compare joysticks by name; used by qsort
 //
 static int compareJoysticks(const void* fp, const void* sp)
 {
-    const _GLFWjoystick* fj = fp;
-    const _GLFWjoystick* sj = sp;
+    const _GLFWjoystick* fj = *((_GLFWjoystick* const*) fp);
+    const _GLFWjoystick* sj = *((_GLFWjoystick* const*) sp);
     return strcmp(fj->linjs.path, sj->linjs.path);
 }
 
@@ -264,9 +332,115 @@ static int compareJoysticks(const void* fp, const void* sp)
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+void _glfwDetectJoystickConnectionLinux(void)
+{
+    if (_glfw.linjs.inotify <= 0)
+        return;
+
+    ssize_t offset = 0;
+    char buffer[16384];
+    const ssize_t size = read(_glfw.linjs.inotify, buffer, sizeof(buffer));
+
+    while (size > offset)
+    {
+        regmatch_t match;
+        const struct inotify_event* e = (struct inotify_event*) (buffer + offset);
+
+        offset += sizeof(struct inotify_event) + e->len;
+
+        if (regexec(&_glfw.linjs.regex, e->name, 1, &match, 0) != 0)
+            continue;
+
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "/dev/input/%s", e->name);
+
+        if (e->mask & (IN_CREATE | IN_ATTRIB))
+        {
+            _GLFWjoystick* js = openJoystickDevice(path);
+            if (js)
+                _glfwInputJoystick(js, GLFW_CONNECTED);
+        }
+        else if (e->mask & IN_DELETE)
+        {
+            for (int jid = 0;  jid < _glfw.joystickCount;  jid++)
+            {
+                _GLFWjoystick* js = _glfw.joysticks[jid];
+                if (!js->present || js->isVirtual)
+                    continue;
+
+                if (strcmp(js->linjs.path, path) == 0)
+                {
+                    closeJoystick(js);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Retrieves the file descriptors to wait on for joystick events
+// The device file descriptors are only included if there is a joystick input
+// callback to deliver their events to
+//
+const int* _glfwGetJoystickFdsLinux(int* count)
+{
+    *count = 0;
+
+    if (_glfw.linjs.fdCapacity < 1 + _glfw.joystickCount)
+    {
+        int* fds = realloc(_glfw.linjs.fds,
+                           (1 + _glfw.joystickCount) * sizeof(int));
+        if (!fds)
+        {
+            // Joystick events are then only read when joysticks are polled
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return _glfw.linjs.fds;
+        }
+
+        _glfw.linjs.fds = fds;
+        _glfw.linjs.fdCapacity = 1 + _glfw.joystickCount;
+    }
+
+    if (_glfw.linjs.inotify > 0)
+        _glfw.linjs.fds[(*count)++] = _glfw.linjs.inotify;
+
+    if (hasInputCallbacks())
+    {
+        for (int jid = 0;  jid < _glfw.joystickCount;  jid++)
+        {
+            const _GLFWjoystick* js = _glfw.joysticks[jid];
+            if (js->present && !js->isVirtual)
+                _glfw.linjs.fds[(*count)++] = js->linjs.fd;
+        }
+    }
+
+    return _glfw.linjs.fds;
+}
+
+// Reads queued input events of all joysticks and reports them to the joystick
+// input callbacks
+//
+void _glfwPollJoysticksLinux(void)
+{
+    if (!hasInputCallbacks())
+        return;
+
+    for (int jid = 0;  jid < _glfw.joystickCount;  jid++)
+    {
+        _GLFWjoystick* js = _glfw.joysticks[jid];
+        if (js->present && !js->isVirtual)
+            _glfwPlatformPollJoystick(js, _GLFW_POLL_ALL);
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW platform API                      //////
+//////////////////////////////////////////////////////////////////////////
+
 // Initialize joystick interface
 //
-GLFWbool _glfwInitJoysticksLinux(void)
+GLFWbool _glfwPlatformInitJoysticks(void)
 {
     const char* dirname = "/dev/input";
 
@@ -286,6 +460,15 @@ GLFWbool _glfwInitJoysticksLinux(void)
     if (regcomp(&_glfw.linjs.regex, "^event[0-9]\\+$", 0) != 0)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR, "Linux: Failed to compile regex");
+
+        if (_glfw.linjs.inotify > 0)
+        {
+            if (_glfw.linjs.watch > 0)
+                inotify_rm_watch(_glfw.linjs.inotify, _glfw.linjs.watch);
+
+            close(_glfw.linjs.inotify);
+        }
+
         return GLFW_FALSE;
     }
 
@@ -316,23 +499,32 @@ GLFWbool _glfwInitJoysticksLinux(void)
 
     // Continue with no joysticks if enumeration fails
 
-    qsort(_glfw.joysticks, count, sizeof(_GLFWjoystick), compareJoysticks);
+    qsort(_glfw.joysticks, count, sizeof(_GLFWjoystick*), compareJoysticks);
+
+    // Report the initial joysticks only once they have their final IDs
+    for (int jid = 0;  jid < count;  jid++)
+    {
+        _glfw.joysticks[jid]->jid = jid;
+        _glfwInputJoystick(_glfw.joysticks[jid], GLFW_CONNECTED);
+    }
+
     return GLFW_TRUE;
 }
 
 // Close all opened joystick handles
 //
-void _glfwTerminateJoysticksLinux(void)
+void _glfwPlatformTerminateJoysticks(void)
 {
     int jid;
 
-    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    for (jid = 0;  jid < _glfw.joystickCount;  jid++)
     {
-        _GLFWjoystick* js = _glfw.joysticks + jid;
+        _GLFWjoystick* js = _glfw.joysticks[jid];
         if (js->present)
             closeJoystick(js);
     }
 
+    free(_glfw.linjs.fds);
     regfree(&_glfw.linjs.regex);
 
     if (_glfw.linjs.inotify > 0)
@@ -344,49 +536,6 @@ void _glfwTerminateJoysticksLinux(void)
     }
 }
 
-void _glfwDetectJoystickConnectionLinux(void)
-{
-    if (_glfw.linjs.inotify <= 0)
-        return;
-
-    ssize_t offset = 0;
-    char buffer[16384];
-    const ssize_t size = read(_glfw.linjs.inotify, buffer, sizeof(buffer));
-
-    while (size > offset)
-    {
-        regmatch_t match;
-        const struct inotify_event* e = (struct inotify_event*) (buffer + offset);
-
-        offset += sizeof(struct inotify_event) + e->len;
-
-        if (regexec(&_glfw.linjs.regex, e->name, 1, &match, 0) != 0)
-            continue;
-
-        char path[PATH_MAX];
-        snprintf(path, sizeof(path), "/dev/input/%s", e->name);
-
-        if (e->mask & (IN_CREATE | IN_ATTRIB))
-            openJoystickDevice(path);
-        else if (e->mask & IN_DELETE)
-        {
-            for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
-            {
-                if (strcmp(_glfw.joysticks[jid].linjs.path, path) == 0)
-                {
-                    closeJoystick(_glfw.joysticks + jid);
-                    break;
-                }
-            }
-        }
-    }
-}
-
-
-//////////////////////////////////////////////////////////////////////////
-//////                       GLFW platform API                      //////
-//////////////////////////////////////////////////////////////////////////
-
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
 {
     // Read all queued events (non-blocking)
@@ -404,6 +553,13 @@ int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
             break;
         }
 
+        if (js->linjs.timestamps)
+        {
+            const uint64_t frequency = _glfwPlatformGetTimerFrequency();
+            js->eventTime = (uint64_t) e.input_event_sec * frequency +
+                            (uint64_t) e.input_event_usec * (frequency / 1000000);
+        }
+
         if (e.type == EV_SYN)
         {
             if (e.code == SYN_DROPPED)
@@ -424,6 +580,7 @@ int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
             handleAbsEvent(js, e.code, e.value);
     }
 
+    js->eventTime = 0;
     return js->present;
 }
 
@@ -38,11 +38,15 @@
 typedef struct _GLFWjoystickLinux
 {
     int                     fd;
-    char                    path[PATH_MAX];
-    int                     keyMap[KEY_CNT - BTN_MISC];
-    int                     absMap[ABS_CNT];
-    struct input_absinfo    absInfo[ABS_CNT];
+    char*                   path;
+    // Sorted key codes of the buttons, indexed by button
+    unsigned short*         keyCodes;
+    // Axis or hat index of each absolute axis code, or -1 if unused
+    signed char             absMap[ABS_CNT];
+    // Absolute axis ranges, indexed by axis
+    struct input_absinfo*   absInfo;
     int                     hats[4][2];
+    GLFWbool                timestamps;
 } _GLFWjoystickLinux;
 
 // Linux-specific joystick API data
@@ -53,10 +57,12 @@ typedef struct _GLFWlibraryLinux
     int                     watch;
     regex_t                 regex;
     GLFWbool                dropped;
+    int*                    fds;
+    int                     fdCapacity;
 } _GLFWlibraryLinux;
 
 
-GLFWbool _glfwInitJoysticksLinux(void);
-void _glfwTerminateJoysticksLinux(void);
 void _glfwDetectJoystickConnectionLinux(void);
+const int* _glfwGetJoystickFdsLinux(int* count);
+void _glfwPollJoysticksLinux(void);
 
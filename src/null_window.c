@@ -198,6 +198,10 @@ void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity)
 {
 }
 
+void _glfwPlatformSetWindowRenderScale(_GLFWwindow* window, float scale)
+{
+}
+
 void _glfwPlatformSetRawMouseMotion(_GLFWwindow *window, GLFWbool enabled)
 {
 }
@@ -207,6 +211,10 @@ GLFWbool _glfwPlatformRawMouseMotionSupported(void)
     return GLFW_FALSE;
 }
 
+void _glfwPlatformUpdateTextInput(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformShowWindow(_GLFWwindow* window)
 {
 }
@@ -216,6 +224,10 @@ void _glfwPlatformRequestWindowAttention(_GLFWwindow* window)
 {
 }
 
+void _glfwPlatformRequestWindowFrame(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformUnhideWindow(_GLFWwindow* window)
 {
 }
@@ -300,6 +312,20 @@ const char* _glfwPlatformGetClipboardString(void)
     return NULL;
 }
 
+GLFWbool _glfwPlatformRequestClipboardString(void)
+{
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformCancelClipboardRequest(void)
+{
+}
+
+GLFWbool _glfwPlatformSetClipboardProvider(void)
+{
+    return GLFW_FALSE;
+}
+
 const char* _glfwPlatformGetScancodeName(int scancode)
 {
     return "";
@@ -580,7 +580,6 @@ int _glfwPlatformInit(void)
         return GLFW_FALSE;
 
     _glfwInitTimerWin32();
-    _glfwInitJoysticksWin32();
 
     _glfwPollMonitorsWin32();
     return GLFW_TRUE;
@@ -607,8 +606,6 @@ void _glfwPlatformTerminate(void)
     _glfwTerminateWGL();
     _glfwTerminateEGL();
 
-    _glfwTerminateJoysticksWin32();
-
     freeLibraries();
 }
 
@@ -354,10 +354,10 @@ static BOOL CALLBACK deviceCallback(const DIDEVICEINSTANCE* di, void* user)
     char guid[33];
     char name[256];
 
-    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    for (jid = 0;  jid < _glfw.joystickCount;  jid++)
     {
-        js = _glfw.joysticks + jid;
-        if (js->present)
+        js = _glfw.joysticks[jid];
+        if (js->present && !js->isVirtual)
         {
             if (memcmp(&js->win32.guid, &di->guidInstance, sizeof(GUID)) == 0)
                 return DIENUM_CONTINUE;
@@ -491,39 +491,6 @@ static BOOL CALLBACK deviceCallback(const DIDEVICEINSTANCE* di, void* user)
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
-// Initialize joystick interface
-//
-void _glfwInitJoysticksWin32(void)
-{
-    if (_glfw.win32.dinput8.instance)
-    {
-        if (FAILED(DirectInput8Create(GetModuleHandle(NULL),
-                                      DIRECTINPUT_VERSION,
-                                      &IID_IDirectInput8W,
-                                      (void**) &_glfw.win32.dinput8.api,
-                                      NULL)))
-        {
-            _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "Win32: Failed to create interface");
-        }
-    }
-
-    _glfwDetectJoystickConnectionWin32();
-}
-
-// Close all opened joystick handles
-//
-void _glfwTerminateJoysticksWin32(void)
-{
-    int jid;
-
-    for (jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
-        closeJoystick(_glfw.joysticks + jid);
-
-    if (_glfw.win32.dinput8.api)
-        IDirectInput8_Release(_glfw.win32.dinput8.api);
-}
-
 // Checks for new joysticks after DBT_DEVICEARRIVAL
 //
 void _glfwDetectJoystickConnectionWin32(void)
@@ -539,17 +506,18 @@ void _glfwDetectJoystickConnectionWin32(void)
             XINPUT_CAPABILITIES xic;
             _GLFWjoystick* js;
 
-            for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+            for (jid = 0;  jid < _glfw.joystickCount;  jid++)
             {
-                if (_glfw.joysticks[jid].present &&
-                    _glfw.joysticks[jid].win32.device == NULL &&
-                    _glfw.joysticks[jid].win32.index == index)
+                if (_glfw.joysticks[jid]->present &&
+                    !_glfw.joysticks[jid]->isVirtual &&
+                    _glfw.joysticks[jid]->win32.device == NULL &&
+                    _glfw.joysticks[jid]->win32.index == index)
                 {
                     break;
                 }
             }
 
-            if (jid <= GLFW_JOYSTICK_LAST)
+            if (jid < _glfw.joystickCount)
                 continue;
 
             if (XInputGetCapabilities(index, 0, &xic) != ERROR_SUCCESS)
@@ -590,10 +558,10 @@ void _glfwDetectJoystickDisconnectionWin32(void)
 {
     int jid;
 
-    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    for (jid = 0;  jid < _glfw.joystickCount;  jid++)
     {
-        _GLFWjoystick* js = _glfw.joysticks + jid;
-        if (js->present)
+        _GLFWjoystick* js = _glfw.joysticks[jid];
+        if (js->present && !js->isVirtual)
             _glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE);
     }
 }
@@ -603,6 +571,40 @@ void _glfwDetectJoystickDisconnectionWin32(void)
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Initialize joystick interface
+//
+GLFWbool _glfwPlatformInitJoysticks(void)
+{
+    if (_glfw.win32.dinput8.instance)
+    {
+        if (FAILED(DirectInput8Create(GetModuleHandle(NULL),
+                                      DIRECTINPUT_VERSION,
+                                      &IID_IDirectInput8W,
+                                      (void**) &_glfw.win32.dinput8.api,
+                                      NULL)))
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Win32: Failed to create interface");
+        }
+    }
+
+    _glfwDetectJoystickConnectionWin32();
+    return GLFW_TRUE;
+}
+
+// Close all opened joystick handles
+//
+void _glfwPlatformTerminateJoysticks(void)
+{
+    int jid;
+
+    for (jid = 0;  jid < _glfw.joystickCount;  jid++)
+        closeJoystick(_glfw.joysticks[jid]);
+
+    if (_glfw.win32.dinput8.api)
+        IDirectInput8_Release(_glfw.win32.dinput8.api);
+}
+
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
 {
     if (js->win32.device)
@@ -98,17 +98,15 @@ static const GLFWimage* chooseImage(int count, const GLFWimage* images,
 
 // Creates an RGBA icon or cursor
 //
-static HICON createIcon(const GLFWimage* image,
+static HICON createIcon(const GLFWimage* image, int format,
                         int xhot, int yhot, GLFWbool icon)
 {
-    int i;
     HDC dc;
     HICON handle;
     HBITMAP color, mask;
     BITMAPV5HEADER bi;
     ICONINFO ii;
     unsigned char* target = NULL;
-    unsigned char* source = image->pixels;
 
     ZeroMemory(&bi, sizeof(bi));
     bi.bV5Size        = sizeof(bi);
@@ -147,15 +145,7 @@ static HICON createIcon(const GLFWimage* image,
         return NULL;
     }
 
-    for (i = 0;  i < image->width * image->height;  i++)
-    {
-        target[0] = source[2];
-        target[1] = source[1];
-        target[2] = source[0];
-        target[3] = source[3];
-        target += 4;
-        source += 4;
-    }
+    _glfwConvertImage(image, format, _GLFW_PIXELS_BGRA, GLFW_FALSE, target);
 
     ZeroMemory(&ii, sizeof(ii));
     ii.fIcon    = icon;
@@ -530,6 +520,9 @@ static LRESULT CALLBACK windowProc(HWND hWnd, UINT uMsg,
 
             case WM_DEVICECHANGE:
             {
+                if (!_glfw.joysticksInitialized)
+                    break;
+
                 if (wParam == DBT_DEVICEARRIVAL)
                 {
                     DEV_BROADCAST_HDR* dbh = (DEV_BROADCAST_HDR*) lParam;
@@ -1445,8 +1438,10 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
                                                   GetSystemMetrics(SM_CXSMICON),
                                                   GetSystemMetrics(SM_CYSMICON));
 
-        bigIcon = createIcon(bigImage, 0, 0, GLFW_TRUE);
-        smallIcon = createIcon(smallImage, 0, 0, GLFW_TRUE);
+        bigIcon = createIcon(bigImage, _glfw.hints.imageFormat,
+                             0, 0, GLFW_TRUE);
+        smallIcon = createIcon(smallImage, _glfw.hints.imageFormat,
+                               0, 0, GLFW_TRUE);
     }
     else
     {
@@ -1653,6 +1648,10 @@ void _glfwPlatformRequestWindowAttention(_GLFWwindow* window)
     FlashWindow(window->win32.handle, TRUE);
 }
 
+void _glfwPlatformRequestWindowFrame(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformFocusWindow(_GLFWwindow* window)
 {
     BringWindowToTop(window->win32.handle);
@@ -1858,6 +1857,10 @@ void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity)
     }
 }
 
+void _glfwPlatformSetWindowRenderScale(_GLFWwindow* window, float scale)
+{
+}
+
 void _glfwPlatformSetRawMouseMotion(_GLFWwindow *window, GLFWbool enabled)
 {
     if (_glfw.win32.disabledCursorWindow != window)
@@ -1874,6 +1877,10 @@ GLFWbool _glfwPlatformRawMouseMotionSupported(void)
     return GLFW_TRUE;
 }
 
+void _glfwPlatformUpdateTextInput(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformPollEvents(void)
 {
     MSG msg;
@@ -2036,7 +2043,8 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
                               const GLFWimage* image,
                               int xhot, int yhot)
 {
-    cursor->win32.handle = (HCURSOR) createIcon(image, xhot, yhot, GLFW_FALSE);
+    cursor->win32.handle = (HCURSOR) createIcon(image, cursor->format,
+                                                xhot, yhot, GLFW_FALSE);
     if (!cursor->win32.handle)
         return GLFW_FALSE;
 
@@ -2169,6 +2177,22 @@ const char* _glfwPlatformGetClipboardString(void)
     return _glfw.win32.clipboardString;
 }
 
+GLFWbool _glfwPlatformRequestClipboardString(void)
+{
+    // The clipboard is read synchronously by shared code
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformCancelClipboardRequest(void)
+{
+}
+
+GLFWbool _glfwPlatformSetClipboardProvider(void)
+{
+    // The clipboard text is set up front by shared code
+    return GLFW_FALSE;
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_win32_surface)
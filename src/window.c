@@ -128,6 +128,27 @@ void _glfwInputWindowDamage(_GLFWwindow* window)
         window->callbacks.refresh((GLFWwindow*) window);
 }
 
+// Notifies shared code that the window is ready for a new frame
+//
+void _glfwInputWindowFrame(_GLFWwindow* window)
+{
+    if (window->callbacks.frame)
+        window->callbacks.frame((GLFWwindow*) window);
+}
+
+// Notifies shared code that a frame of the window has reached the display
+//
+void _glfwInputWindowPresentation(_GLFWwindow* window,
+                                  uint64_t time,
+                                  double refresh,
+                                  uint64_t sequence)
+{
+    window->presentation.valid = GLFW_TRUE;
+    window->presentation.time = time;
+    window->presentation.refresh = refresh;
+    window->presentation.sequence = sequence;
+}
+
 // Notifies shared code that the user wishes to close a window
 //
 void _glfwInputWindowCloseRequest(_GLFWwindow* window)
@@ -438,6 +459,28 @@ GLFWAPI void glfwWindowHintString(int hint, const char* value)
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid window hint string 0x%08X", hint);
 }
 
+GLFWAPI void glfwImageHint(int hint, int value)
+{
+    _GLFW_REQUIRE_INIT();
+
+    switch (hint)
+    {
+        case GLFW_IMAGE_FORMAT:
+            if (value != GLFW_IMAGE_RGBA &&
+                value != GLFW_IMAGE_BGRA_PREMULTIPLIED)
+            {
+                _glfwInputError(GLFW_INVALID_VALUE,
+                                "Invalid image format 0x%08X", value);
+                return;
+            }
+
+            _glfw.hints.imageFormat = value;
+            return;
+    }
+
+    _glfwInputError(GLFW_INVALID_ENUM, "Invalid image hint 0x%08X", hint);
+}
+
 GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -718,6 +761,25 @@ GLFWAPI void glfwSetWindowOpacity(GLFWwindow* handle, float opacity)
     _glfwPlatformSetWindowOpacity(window, opacity);
 }
 
+GLFWAPI void glfwSetWindowRenderScale(GLFWwindow* handle, float scale)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(scale == scale);
+    assert(scale > 0.f);
+    assert(scale <= 1.f);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (scale != scale || scale <= 0.f || scale > 1.f)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid window render scale %f", scale);
+        return;
+    }
+
+    _glfwPlatformSetWindowRenderScale(window, scale);
+}
+
 GLFWAPI void glfwIconifyWindow(GLFWwindow* handle)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -1011,6 +1073,54 @@ GLFWAPI GLFWwindowrefreshfun glfwSetWindowRefreshCallback(GLFWwindow* handle,
     return cbfun;
 }
 
+GLFWAPI GLFWwindowframefun glfwSetWindowFrameCallback(GLFWwindow* handle,
+                                                      GLFWwindowframefun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.frame, cbfun);
+
+    if (window->callbacks.frame)
+        _glfwPlatformRequestWindowFrame(window);
+
+    return cbfun;
+}
+
+GLFWAPI int glfwGetWindowPresentationTime(GLFWwindow* handle,
+                                          double* time,
+                                          double* refresh,
+                                          uint64_t* sequence)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (time)
+        *time = 0.0;
+    if (refresh)
+        *refresh = 0.0;
+    if (sequence)
+        *sequence = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!window->presentation.valid)
+        return GLFW_FALSE;
+
+    if (time)
+    {
+        *time = (double) (int64_t) (window->presentation.time - _glfw.timer.offset) /
+            _glfwPlatformGetTimerFrequency();
+    }
+    if (refresh)
+        *refresh = window->presentation.refresh;
+    if (sequence)
+        *sequence = window->presentation.sequence;
+
+    return GLFW_TRUE;
+}
+
 GLFWAPI GLFWwindowfocusfun glfwSetWindowFocusCallback(GLFWwindow* handle,
                                                       GLFWwindowfocusfun cbfun)
 {
@@ -1070,12 +1180,23 @@ GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
     _glfwPlatformPollEvents();
+    _glfwPollClipboardRequest();
 }
 
 GLFWAPI void glfwWaitEvents(void)
 {
     _GLFW_REQUIRE_INIT();
-    _glfwPlatformWaitEvents();
+
+    // Waiting ends by the deadline of a pending clipboard request
+    if (_glfw.clipboardRequest.pending)
+    {
+        const double timeout = _glfwGetClipboardRequestTimeout(DBL_MAX);
+        _glfwPlatformWaitEventsTimeout(timeout);
+    }
+    else
+        _glfwPlatformWaitEvents();
+
+    _glfwPollClipboardRequest();
 }
 
 GLFWAPI void glfwWaitEventsTimeout(double timeout)
@@ -1091,7 +1212,8 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout)
         return;
     }
 
-    _glfwPlatformWaitEventsTimeout(timeout);
+    _glfwPlatformWaitEventsTimeout(_glfwGetClipboardRequestTimeout(timeout));
+    _glfwPollClipboardRequest();
 }
 
 GLFWAPI void glfwPostEmptyEvent(void)
@@ -26,10 +26,13 @@
 // It is fine to use C99 in this file because it will not be built with VS
 //========================================================================
 
+#define _GNU_SOURCE
+
 #include "internal.h"
 
 #include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <linux/input.h>
 #include <stdio.h>
@@ -37,6 +40,7 @@
 #include <string.h>
 #include <sys/mman.h>
 #include <sys/timerfd.h>
+#include <time.h>
 #include <unistd.h>
 #include <wayland-client.h>
 
@@ -46,38 +50,20 @@ static inline int min(int n1, int n2)
     return n1 < n2 ? n1 : n2;
 }
 
-static _GLFWwindow* findWindowFromDecorationSurface(struct wl_surface* surface,
-                                                    int* which)
+// Returns which of the surfaces of the specified window the specified surface is
+//
+static int getSurfaceSide(_GLFWwindow* window, struct wl_surface* surface)
 {
-    int focus;
-    _GLFWwindow* window = _glfw.windowListHead;
-    if (!which)
-        which = &focus;
-    while (window)
-    {
-        if (surface == window->wl.decorations.top.surface)
-        {
-            *which = topDecoration;
-            break;
-        }
-        if (surface == window->wl.decorations.left.surface)
-        {
-            *which = leftDecoration;
-            break;
-        }
-        if (surface == window->wl.decorations.right.surface)
-        {
-            *which = rightDecoration;
-            break;
-        }
-        if (surface == window->wl.decorations.bottom.surface)
-        {
-            *which = bottomDecoration;
-            break;
-        }
-        window = window->next;
-    }
-    return window;
+    if (surface == window->wl.decorations.top.surface)
+        return topDecoration;
+    if (surface == window->wl.decorations.left.surface)
+        return leftDecoration;
+    if (surface == window->wl.decorations.right.surface)
+        return rightDecoration;
+    if (surface == window->wl.decorations.bottom.surface)
+        return bottomDecoration;
+
+    return mainWindow;
 }
 
 static void pointerHandleEnter(void* data,
@@ -91,16 +77,12 @@ static void pointerHandleEnter(void* data,
     if (!surface)
         return;
 
-    int focus = 0;
+    // The main and decoration surfaces of windows have the window as user data
     _GLFWwindow* window = wl_surface_get_user_data(surface);
     if (!window)
-    {
-        window = findWindowFromDecorationSurface(surface, &focus);
-        if (!window)
-            return;
-    }
+        return;
 
-    window->wl.decorations.focus = focus;
+    window->wl.decorations.focus = getSurfaceSide(window, surface);
     _glfw.wl.serial = serial;
     _glfw.wl.pointerFocus = window;
 
@@ -362,6 +344,70 @@ static const struct wl_pointer_listener pointerListener = {
     pointerHandleAxis,
 };
 
+// Returns the 64-bit FNV-1a hash of the specified keymap text
+//
+static uint64_t hashKeymap(const char* text, uint32_t size)
+{
+    uint64_t hash = 14695981039346656037u;
+
+    for (uint32_t i = 0;  i < size;  i++)
+    {
+        hash ^= (unsigned char) text[i];
+        hash *= 1099511628211u;
+    }
+
+    return hash;
+}
+
+// Returns a new reference to the compiled keymap for the specified text,
+// compiling and caching it only if it has not been seen recently
+//
+static struct xkb_keymap* compileKeymap(const char* text, uint32_t size)
+{
+    const uint64_t hash = hashKeymap(text, size);
+
+    for (int i = 0;  i < _GLFW_KEYMAP_CACHE_SIZE;  i++)
+    {
+        // The hash only rules out most entries, the text decides
+        const _GLFWkeymapWayland* entry = _glfw.wl.xkb.keymaps + i;
+        if (entry->keymap && entry->hash == hash && entry->size == size &&
+            memcmp(entry->text, text, size) == 0)
+        {
+            return xkb_keymap_ref(entry->keymap);
+        }
+    }
+
+    struct xkb_keymap* keymap =
+        xkb_keymap_new_from_string(_glfw.wl.xkb.context,
+                                   text,
+                                   XKB_KEYMAP_FORMAT_TEXT_V1,
+                                   0);
+    if (!keymap)
+        return NULL;
+
+    // The keymap is still usable if there is no memory to cache it
+    char* copy = malloc(size);
+    if (!copy)
+        return keymap;
+
+    memcpy(copy, text, size);
+
+    _GLFWkeymapWayland* entry = _glfw.wl.xkb.keymaps + _glfw.wl.xkb.nextKeymap;
+    _glfw.wl.xkb.nextKeymap =
+        (_glfw.wl.xkb.nextKeymap + 1) % _GLFW_KEYMAP_CACHE_SIZE;
+
+    if (entry->keymap)
+        xkb_keymap_unref(entry->keymap);
+
+    free(entry->text);
+
+    entry->hash = hash;
+    entry->size = size;
+    entry->text = copy;
+    entry->keymap = xkb_keymap_ref(keymap);
+    return keymap;
+}
+
 static void keyboardHandleKeymap(void* data,
                                  struct wl_keyboard* keyboard,
                                  uint32_t format,
@@ -370,14 +416,7 @@ static void keyboardHandleKeymap(void* data,
 {
     struct xkb_keymap* keymap;
     struct xkb_state* state;
-
-#ifdef HAVE_XKBCOMMON_COMPOSE_H
-    struct xkb_compose_table* composeTable;
-    struct xkb_compose_state* composeState;
-#endif
-
     char* mapStr;
-    const char* locale;
 
     if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1)
     {
@@ -391,10 +430,8 @@ static void keyboardHandleKeymap(void* data,
         return;
     }
 
-    keymap = xkb_keymap_new_from_string(_glfw.wl.xkb.context,
-                                        mapStr,
-                                        XKB_KEYMAP_FORMAT_TEXT_V1,
-                                        0);
+    // The size includes the terminating null character
+    keymap = compileKeymap(mapStr, size);
     munmap(mapStr, size);
     close(fd);
 
@@ -414,42 +451,14 @@ static void keyboardHandleKeymap(void* data,
         return;
     }
 
-    // Look up the preferred locale, falling back to "C" as default.
-    locale = getenv("LC_ALL");
-    if (!locale)
-        locale = getenv("LC_CTYPE");
-    if (!locale)
-        locale = getenv("LANG");
-    if (!locale)
-        locale = "C";
-
-#ifdef HAVE_XKBCOMMON_COMPOSE_H
-    composeTable =
-        xkb_compose_table_new_from_locale(_glfw.wl.xkb.context, locale,
-                                          XKB_COMPOSE_COMPILE_NO_FLAGS);
-    if (composeTable)
-    {
-        composeState =
-            xkb_compose_state_new(composeTable, XKB_COMPOSE_STATE_NO_FLAGS);
-        xkb_compose_table_unref(composeTable);
-        if (composeState)
-            _glfw.wl.xkb.composeState = composeState;
-        else
-            _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "Wayland: Failed to create XKB compose state");
-    }
-    else
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to create XKB compose table");
-    }
-#endif
-
     xkb_keymap_unref(_glfw.wl.xkb.keymap);
     xkb_state_unref(_glfw.wl.xkb.state);
     _glfw.wl.xkb.keymap = keymap;
     _glfw.wl.xkb.state = state;
 
+    // Key names are looked up anew for the new keymap
+    memset(_glfw.wl.keynameLayouts, 0, sizeof(_glfw.wl.keynameLayouts));
+
     _glfw.wl.xkb.controlMask =
         1 << xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Control");
     _glfw.wl.xkb.altMask =
@@ -476,11 +485,7 @@ static void keyboardHandleEnter(void* data,
 
     _GLFWwindow* window = wl_surface_get_user_data(surface);
     if (!window)
-    {
-        window = findWindowFromDecorationSurface(surface, NULL);
-        if (!window)
-            return;
-    }
+        return;
 
     _glfw.wl.serial = serial;
     _glfw.wl.keyboardFocus = window;
@@ -511,9 +516,65 @@ static int toGLFWKeyCode(uint32_t key)
 }
 
 #ifdef HAVE_XKBCOMMON_COMPOSE_H
+// Creates the compose state for the current locale
+// The compose table does not depend on the keymap, so this is only done once
+//
+static void loadComposeTable(void)
+{
+    struct xkb_compose_table* composeTable;
+    const char* locale;
+
+    _glfw.wl.xkb.composeLoaded = GLFW_TRUE;
+
+    // Look up the preferred locale, falling back to "C" as default.
+    locale = getenv("LC_ALL");
+    if (!locale)
+        locale = getenv("LC_CTYPE");
+    if (!locale)
+        locale = getenv("LANG");
+    if (!locale)
+        locale = "C";
+
+    composeTable =
+        xkb_compose_table_new_from_locale(_glfw.wl.xkb.context, locale,
+                                          XKB_COMPOSE_COMPILE_NO_FLAGS);
+    if (!composeTable)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create XKB compose table");
+        return;
+    }
+
+    _glfw.wl.xkb.composeState =
+        xkb_compose_state_new(composeTable, XKB_COMPOSE_STATE_NO_FLAGS);
+    xkb_compose_table_unref(composeTable);
+    if (!_glfw.wl.xkb.composeState)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create XKB compose state");
+    }
+}
+
 static xkb_keysym_t composeSymbol(xkb_keysym_t sym)
 {
-    if (sym == XKB_KEY_NoSymbol || !_glfw.wl.xkb.composeState)
+    if (sym == XKB_KEY_NoSymbol)
+        return sym;
+
+    if (!_glfw.wl.xkb.composeLoaded)
+    {
+        // Sequences start with a dead key, in the range from dead_grave to
+        // dead_longsolidusoverlay, or with the Compose key
+        if ((sym < XKB_KEY_dead_grave ||
+             sym > XKB_KEY_dead_longsolidusoverlay) &&
+            sym != XKB_KEY_Multi_key)
+        {
+            return sym;
+        }
+
+        loadComposeTable();
+    }
+
+    if (!_glfw.wl.xkb.composeState)
         return sym;
     if (xkb_compose_state_feed(_glfw.wl.xkb.composeState, sym)
             != XKB_COMPOSE_FEED_ACCEPTED)
@@ -542,6 +603,9 @@ static GLFWbool inputChar(_GLFWwindow* window, uint32_t key)
     code = key + 8;
     numSyms = xkb_state_key_get_syms(_glfw.wl.xkb.state, code, &syms);
 
+    const int mods = _glfw.wl.xkb.modifiers;
+    const int plain = !(mods & (GLFW_MOD_CONTROL | GLFW_MOD_ALT));
+
     if (numSyms == 1)
     {
 #ifdef HAVE_XKBCOMMON_COMPOSE_H
@@ -551,11 +615,29 @@ static GLFWbool inputChar(_GLFWwindow* window, uint32_t key)
 #endif
         cp = _glfwKeySym2Unicode(sym);
         if (cp != -1)
-        {
-            const int mods = _glfw.wl.xkb.modifiers;
-            const int plain = !(mods & (GLFW_MOD_CONTROL | GLFW_MOD_ALT));
             _glfwInputChar(window, cp, mods, plain);
+    }
+    else if (numSyms > 1)
+    {
+        // The code points of a key that produces several keysyms are reported
+        // as a single text event, like an input method commit
+        unsigned int* codepoints = calloc(numSyms, sizeof(unsigned int));
+        if (!codepoints)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return GLFW_FALSE;
+        }
+
+        int count = 0;
+        for (uint32_t i = 0;  i < numSyms;  i++)
+        {
+            cp = _glfwKeySym2Unicode(syms[i]);
+            if (cp != -1)
+                codepoints[count++] = (unsigned int) cp;
         }
+
+        _glfwInputText(window, codepoints, count, mods, plain);
+        free(codepoints);
     }
 
     return xkb_keymap_key_repeats(_glfw.wl.xkb.keymap, syms[0]);
@@ -711,10 +793,39 @@ static const struct wl_seat_listener seatListener = {
     seatHandleName,
 };
 
+// Removes the specified offer from the list of unclaimed offers, returning
+// whether it carries paths
+//
+static GLFWbool claimDataOffer(struct wl_data_offer* offer)
+{
+    for (int i = 0;  i < _glfw.wl.offerCount;  i++)
+    {
+        if (_glfw.wl.offers[i].offer == offer)
+        {
+            const GLFWbool uriList = _glfw.wl.offers[i].text_uri_list;
+            _glfw.wl.offers[i] = _glfw.wl.offers[--_glfw.wl.offerCount];
+            return uriList;
+        }
+    }
+
+    return GLFW_FALSE;
+}
+
 static void dataOfferHandleOffer(void* data,
                                  struct wl_data_offer* dataOffer,
                                  const char* mimeType)
 {
+    if (strcmp(mimeType, "text/uri-list") != 0)
+        return;
+
+    for (int i = 0;  i < _glfw.wl.offerCount;  i++)
+    {
+        if (_glfw.wl.offers[i].offer == dataOffer)
+        {
+            _glfw.wl.offers[i].text_uri_list = GLFW_TRUE;
+            return;
+        }
+    }
 }
 
 static const struct wl_data_offer_listener dataOfferListener = {
@@ -725,11 +836,20 @@ static void dataDeviceHandleDataOffer(void* data,
                                       struct wl_data_device* dataDevice,
                                       struct wl_data_offer* id)
 {
-    if (_glfw.wl.dataOffer)
-        wl_data_offer_destroy(_glfw.wl.dataOffer);
+    // The offer is claimed by the enter or selection event that follows its
+    // MIME types
+    _GLFWofferWayland* offers =
+        realloc(_glfw.wl.offers,
+                sizeof(_GLFWofferWayland) * (_glfw.wl.offerCount + 1));
+    if (!offers)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return;
+    }
 
-    _glfw.wl.dataOffer = id;
-    wl_data_offer_add_listener(_glfw.wl.dataOffer, &dataOfferListener, NULL);
+    _glfw.wl.offers = offers;
+    _glfw.wl.offers[_glfw.wl.offerCount++] = (_GLFWofferWayland) { id };
+    wl_data_offer_add_listener(id, &dataOfferListener, NULL);
 }
 
 static void dataDeviceHandleEnter(void* data,
@@ -740,11 +860,46 @@ static void dataDeviceHandleEnter(void* data,
                                   wl_fixed_t y,
                                   struct wl_data_offer *id)
 {
+    if (_glfw.wl.dragOffer)
+    {
+        wl_data_offer_destroy(_glfw.wl.dragOffer);
+        _glfw.wl.dragOffer = NULL;
+        _glfw.wl.dragFocus = NULL;
+    }
+
+    if (!id)
+        return;
+
+    const GLFWbool uriList = claimDataOffer(id);
+
+    // Only the main surface of a window accepts drops, as the drop position is
+    // relative to it
+    _GLFWwindow* window = surface ? wl_surface_get_user_data(surface) : NULL;
+    if (window && surface != window->wl.surface)
+        window = NULL;
+
+    if (window && uriList)
+    {
+        _glfw.wl.dragOffer = id;
+        _glfw.wl.dragFocus = window;
+        wl_data_offer_accept(id, serial, "text/uri-list");
+    }
+    else
+    {
+        wl_data_offer_accept(id, serial, NULL);
+        wl_data_offer_destroy(id);
+    }
 }
 
 static void dataDeviceHandleLeave(void* data,
                                   struct wl_data_device* dataDevice)
 {
+    if (_glfw.wl.dragOffer)
+    {
+        wl_data_offer_destroy(_glfw.wl.dragOffer);
+        _glfw.wl.dragOffer = NULL;
+        _glfw.wl.dragFocus = NULL;
+    }
 }
 
 static void dataDeviceHandleMotion(void* data,
@@ -758,12 +913,29 @@ static void dataDeviceHandleMotion(void* data,
 static void dataDeviceHandleDrop(void* data,
                                  struct wl_data_device* dataDevice)
 {
+    if (!_glfw.wl.dragOffer)
+        return;
+
+    // The list is read while events are processed, as the source may be slow
+    // to write it
+    _glfwReceiveDropWayland(_glfw.wl.dragFocus, _glfw.wl.dragOffer);
+
+    wl_data_offer_destroy(_glfw.wl.dragOffer);
+    _glfw.wl.dragOffer = NULL;
+    _glfw.wl.dragFocus = NULL;
 }
 
 static void dataDeviceHandleSelection(void* data,
                                       struct wl_data_device* dataDevice,
                                       struct wl_data_offer* id)
 {
+    if (_glfw.wl.dataOffer)
+        wl_data_offer_destroy(_glfw.wl.dataOffer);
+
+    if (id)
+        claimDataOffer(id);
+
+    _glfw.wl.dataOffer = id;
 }
 
 static const struct wl_data_device_listener dataDeviceListener = {
@@ -786,6 +958,17 @@ static const struct xdg_wm_base_listener wmBaseListener = {
     wmBaseHandlePing
 };
 
+static void presentationHandleClockId(void* data,
+                                      struct wp_presentation* presentation,
+                                      uint32_t clockId)
+{
+    _glfw.wl.presentationClock = clockId;
+}
+
+static const struct wp_presentation_listener presentationListener = {
+    presentationHandleClockId
+};
+
 static void registryHandleGlobal(void* data,
                                  struct wl_registry* registry,
                                  uint32_t name,
@@ -877,6 +1060,17 @@ static void registryHandleGlobal(void* data,
                              &zwp_idle_inhibit_manager_v1_interface,
                              1);
     }
+    else if (strcmp(interface, "wp_presentation") == 0)
+    {
+        // The clock is reported right after binding, but assume the usual one
+        // in case a frame is presented first
+        _glfw.wl.presentationClock = CLOCK_MONOTONIC;
+        _glfw.wl.presentation =
+            wl_registry_bind(registry, name, &wp_presentation_interface, 1);
+        wp_presentation_add_listener(_glfw.wl.presentation,
+                                     &presentationListener,
+                                     NULL);
+    }
 }
 
 static void registryHandleGlobalRemove(void *data,
@@ -1050,6 +1244,10 @@ int _glfwPlatformInit(void)
     long cursorSizeLong;
     int cursorSize;
 
+    // The timer is initialized first, as joystick devices timestamp their
+    // events with the clock it selects
+    _glfwInitTimerPOSIX();
+
     _glfw.wl.cursor.handle = _glfw_dlopen("libwayland-cursor.so.0");
     if (!_glfw.wl.cursor.handle)
     {
@@ -1098,6 +1296,8 @@ int _glfwPlatformInit(void)
         _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_keymap_new_from_string");
     _glfw.wl.xkb.keymap_unref = (PFN_xkb_keymap_unref)
         _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_keymap_unref");
+    _glfw.wl.xkb.keymap_ref = (PFN_xkb_keymap_ref)
+        _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_keymap_ref");
     _glfw.wl.xkb.keymap_mod_get_index = (PFN_xkb_keymap_mod_get_index)
         _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_keymap_mod_get_index");
     _glfw.wl.xkb.keymap_key_repeats = (PFN_xkb_keymap_key_repeats)
@@ -1112,6 +1312,12 @@ int _glfwPlatformInit(void)
         _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_state_update_mask");
     _glfw.wl.xkb.state_serialize_mods = (PFN_xkb_state_serialize_mods)
         _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_state_serialize_mods");
+    _glfw.wl.xkb.state_serialize_layout = (PFN_xkb_state_serialize_layout)
+        _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_state_serialize_layout");
+    _glfw.wl.xkb.state_key_get_layout = (PFN_xkb_state_key_get_layout)
+        _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_state_key_get_layout");
+    _glfw.wl.xkb.keymap_key_get_syms_by_level = (PFN_xkb_keymap_key_get_syms_by_level)
+        _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_keymap_key_get_syms_by_level");
 
 #ifdef HAVE_XKBCOMMON_COMPOSE_H
     _glfw.wl.xkb.compose_table_new_from_locale = (PFN_xkb_compose_table_new_from_locale)
@@ -1157,16 +1363,9 @@ int _glfwPlatformInit(void)
     // Sync so we got all initial output events
     wl_display_roundtrip(_glfw.wl.display);
 
-#ifdef __linux__
-    if (!_glfwInitJoysticksLinux())
-        return GLFW_FALSE;
-#endif
-
-    _glfwInitTimerPOSIX();
-
     _glfw.wl.timerfd = -1;
     if (_glfw.wl.seatVersion >= 4)
-        _glfw.wl.timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        _glfw.wl.timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
 
     if (_glfw.wl.pointer && _glfw.wl.shm)
     {
@@ -1193,7 +1392,7 @@ int _glfwPlatformInit(void)
             wl_cursor_theme_load(cursorTheme, 2 * cursorSize, _glfw.wl.shm);
         _glfw.wl.cursorSurface =
             wl_compositor_create_surface(_glfw.wl.compositor);
-        _glfw.wl.cursorTimerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        _glfw.wl.cursorTimerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
     }
 
     if (_glfw.wl.seat && _glfw.wl.dataDeviceManager)
@@ -1217,9 +1416,6 @@ int _glfwPlatformInit(void)
 
 void _glfwPlatformTerminate(void)
 {
-#ifdef __linux__
-    _glfwTerminateJoysticksLinux();
-#endif
     _glfwTerminateEGL();
     if (_glfw.wl.egl.handle)
     {
@@ -1233,10 +1429,17 @@ void _glfwPlatformTerminate(void)
 #endif
     if (_glfw.wl.xkb.keymap)
         xkb_keymap_unref(_glfw.wl.xkb.keymap);
+    for (int i = 0;  i < _GLFW_KEYMAP_CACHE_SIZE;  i++)
+    {
+        if (_glfw.wl.xkb.keymaps[i].keymap)
+            xkb_keymap_unref(_glfw.wl.xkb.keymaps[i].keymap);
+        free(_glfw.wl.xkb.keymaps[i].text);
+    }
     if (_glfw.wl.xkb.state)
         xkb_state_unref(_glfw.wl.xkb.state);
     if (_glfw.wl.xkb.context)
         xkb_context_unref(_glfw.wl.xkb.context);
+    _glfwTerminateKeySym2Unicode();
     if (_glfw.wl.xkb.handle)
     {
         _glfw_dlclose(_glfw.wl.xkb.handle);
@@ -1271,10 +1474,28 @@ void _glfwPlatformTerminate(void)
         xdg_wm_base_destroy(_glfw.wl.wmBase);
     if (_glfw.wl.dataSource)
         wl_data_source_destroy(_glfw.wl.dataSource);
+
+    for (int i = 0;  i < _glfw.wl.shmPool.blockCount;  i++)
+    {
+        if (_glfw.wl.shmPool.blocks[i].buffer)
+            wl_buffer_destroy(_glfw.wl.shmPool.blocks[i].buffer);
+    }
+    free(_glfw.wl.shmPool.blocks);
+    if (_glfw.wl.shmPool.handle)
+    {
+        wl_shm_pool_destroy(_glfw.wl.shmPool.handle);
+        munmap(_glfw.wl.shmPool.data, _glfw.wl.shmPool.size);
+        close(_glfw.wl.shmPool.fd);
+    }
     if (_glfw.wl.dataDevice)
         wl_data_device_destroy(_glfw.wl.dataDevice);
     if (_glfw.wl.dataOffer)
         wl_data_offer_destroy(_glfw.wl.dataOffer);
+    if (_glfw.wl.dragOffer)
+        wl_data_offer_destroy(_glfw.wl.dragOffer);
+    for (int i = 0;  i < _glfw.wl.offerCount;  i++)
+        wl_data_offer_destroy(_glfw.wl.offers[i].offer);
+    free(_glfw.wl.offers);
     if (_glfw.wl.dataDeviceManager)
         wl_data_device_manager_destroy(_glfw.wl.dataDeviceManager);
     if (_glfw.wl.pointer)
@@ -1289,6 +1510,8 @@ void _glfwPlatformTerminate(void)
         zwp_pointer_constraints_v1_destroy(_glfw.wl.pointerConstraints);
     if (_glfw.wl.idleInhibitManager)
         zwp_idle_inhibit_manager_v1_destroy(_glfw.wl.idleInhibitManager);
+    if (_glfw.wl.presentation)
+        wp_presentation_destroy(_glfw.wl.presentation);
     if (_glfw.wl.registry)
         wl_registry_destroy(_glfw.wl.registry);
     if (_glfw.wl.display)
@@ -1302,6 +1525,21 @@ void _glfwPlatformTerminate(void)
     if (_glfw.wl.cursorTimerfd >= 0)
         close(_glfw.wl.cursorTimerfd);
 
+    if (_glfw.wl.clipboardRequest.active)
+        close(_glfw.wl.clipboardRequest.fd);
+    free(_glfw.wl.clipboardRequest.data);
+
+    if (_glfw.wl.drop.window)
+        close(_glfw.wl.drop.fd);
+    free(_glfw.wl.drop.data);
+
+    for (int i = 0;  i < _glfw.wl.transferCount;  i++)
+    {
+        close(_glfw.wl.transfers[i].fd);
+        free(_glfw.wl.transfers[i].data);
+    }
+    free(_glfw.wl.transfers);
+
     if (_glfw.wl.clipboardString)
         free(_glfw.wl.clipboardString);
     if (_glfw.wl.clipboardSendString)
@@ -62,6 +62,7 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR
 #include "wayland-relative-pointer-unstable-v1-client-protocol.h"
 #include "wayland-pointer-constraints-unstable-v1-client-protocol.h"
 #include "wayland-idle-inhibit-unstable-v1-client-protocol.h"
+#include "wayland-presentation-time-client-protocol.h"
 
 #define _glfw_dlopen(name) dlopen(name, RTLD_LAZY | RTLD_LOCAL)
 #define _glfw_dlclose(handle) dlclose(handle)
@@ -110,6 +111,7 @@ typedef struct xkb_context* (* PFN_xkb_context_new)(enum xkb_context_flags);
 typedef void (* PFN_xkb_context_unref)(struct xkb_context*);
 typedef struct xkb_keymap* (* PFN_xkb_keymap_new_from_string)(struct xkb_context*, const char*, enum xkb_keymap_format, enum xkb_keymap_compile_flags);
 typedef void (* PFN_xkb_keymap_unref)(struct xkb_keymap*);
+typedef struct xkb_keymap* (* PFN_xkb_keymap_ref)(struct xkb_keymap*);
 typedef xkb_mod_index_t (* PFN_xkb_keymap_mod_get_index)(struct xkb_keymap*, const char*);
 typedef int (* PFN_xkb_keymap_key_repeats)(struct xkb_keymap*, xkb_keycode_t);
 typedef struct xkb_state* (* PFN_xkb_state_new)(struct xkb_keymap*);
@@ -117,10 +119,14 @@ typedef void (* PFN_xkb_state_unref)(struct xkb_state*);
 typedef int (* PFN_xkb_state_key_get_syms)(struct xkb_state*, xkb_keycode_t, const xkb_keysym_t**);
 typedef enum xkb_state_component (* PFN_xkb_state_update_mask)(struct xkb_state*, xkb_mod_mask_t, xkb_mod_mask_t, xkb_mod_mask_t, xkb_layout_index_t, xkb_layout_index_t, xkb_layout_index_t);
 typedef xkb_mod_mask_t (* PFN_xkb_state_serialize_mods)(struct xkb_state*, enum xkb_state_component);
+typedef xkb_layout_index_t (* PFN_xkb_state_serialize_layout)(struct xkb_state*, enum xkb_state_component);
+typedef xkb_layout_index_t (* PFN_xkb_state_key_get_layout)(struct xkb_state*, xkb_keycode_t);
+typedef int (* PFN_xkb_keymap_key_get_syms_by_level)(struct xkb_keymap*, xkb_keycode_t, xkb_layout_index_t, xkb_level_index_t, const xkb_keysym_t**);
 #define xkb_context_new _glfw.wl.xkb.context_new
 #define xkb_context_unref _glfw.wl.xkb.context_unref
 #define xkb_keymap_new_from_string _glfw.wl.xkb.keymap_new_from_string
 #define xkb_keymap_unref _glfw.wl.xkb.keymap_unref
+#define xkb_keymap_ref _glfw.wl.xkb.keymap_ref
 #define xkb_keymap_mod_get_index _glfw.wl.xkb.keymap_mod_get_index
 #define xkb_keymap_key_repeats _glfw.wl.xkb.keymap_key_repeats
 #define xkb_state_new _glfw.wl.xkb.state_new
@@ -128,6 +134,9 @@ typedef xkb_mod_mask_t (* PFN_xkb_state_serialize_mods)(struct xkb_state*, enum
 #define xkb_state_key_get_syms _glfw.wl.xkb.state_key_get_syms
 #define xkb_state_update_mask _glfw.wl.xkb.state_update_mask
 #define xkb_state_serialize_mods _glfw.wl.xkb.state_serialize_mods
+#define xkb_state_serialize_layout _glfw.wl.xkb.state_serialize_layout
+#define xkb_state_key_get_layout _glfw.wl.xkb.state_key_get_layout
+#define xkb_keymap_key_get_syms_by_level _glfw.wl.xkb.keymap_key_get_syms_by_level
 
 #ifdef HAVE_XKBCOMMON_COMPOSE_H
 typedef struct xkb_compose_table* (* PFN_xkb_compose_table_new_from_locale)(struct xkb_context*, const char*, enum xkb_compose_compile_flags);
@@ -151,6 +160,16 @@ typedef xkb_keysym_t (* PFN_xkb_compose_state_get_one_sym)(struct xkb_compose_st
 #define _GLFW_DECORATION_VERTICAL (_GLFW_DECORATION_TOP + _GLFW_DECORATION_WIDTH)
 #define _GLFW_DECORATION_HORIZONTAL (2 * _GLFW_DECORATION_WIDTH)
 
+// The number of layouts whose key names are cached at once
+#define _GLFW_KEYNAME_LAYOUTS 4
+// The number of compiled keymaps kept for reuse
+#define _GLFW_KEYMAP_CACHE_SIZE 4
+
+// The last dead keysym, missing from older xkbcommon headers
+#ifndef XKB_KEY_dead_longsolidusoverlay
+ #define XKB_KEY_dead_longsolidusoverlay 0xfe93
+#endif
+
 typedef enum _GLFWdecorationSideWayland
 {
     mainWindow,
@@ -181,7 +200,11 @@ typedef struct _GLFWwindowWayland
     struct wl_surface*          surface;
     struct wl_egl_window*       native;
     struct wl_shell_surface*    shellSurface;
-    struct wl_callback*         callback;
+    struct wl_callback*         frameCallback;
+    // Viewport scaling the framebuffer to the window when the render scale
+    // is not one
+    struct wp_viewport*         viewport;
+    float                       renderScale;
 
     struct {
         struct xdg_surface*     surface;
@@ -208,6 +231,10 @@ typedef struct _GLFWwindowWayland
 
     struct zwp_idle_inhibitor_v1*          idleInhibitor;
 
+    // Presentation feedback requested for frames not yet shown or discarded
+    struct wp_presentation_feedback**      feedbacks;
+    int                                    feedbackCount;
+
     GLFWbool                    wasFullscreen;
 
     struct {
@@ -219,6 +246,49 @@ typedef struct _GLFWwindowWayland
 
 } _GLFWwindowWayland;
 
+// Wayland-specific compiled keymap kept for reuse
+//
+typedef struct _GLFWkeymapWayland
+{
+    // Hash, size and copy of the keymap text it was compiled from
+    uint64_t                    hash;
+    uint32_t                    size;
+    char*                       text;
+    struct xkb_keymap*          keymap;
+} _GLFWkeymapWayland;
+
+// Wayland-specific block of the shared memory pool
+//
+typedef struct _GLFWshmBlockWayland
+{
+    size_t                      offset;
+    size_t                      size;
+    // The buffer using this block, or NULL if the block is free
+    struct wl_buffer*           buffer;
+    // Whether the buffer has been attached and not yet released
+    GLFWbool                    busy;
+    // Whether GLFW is done with the buffer and it only waits to be released
+    GLFWbool                    retired;
+} _GLFWshmBlockWayland;
+
+// Wayland-specific data offer not yet claimed by a selection or drag
+//
+typedef struct _GLFWofferWayland
+{
+    struct wl_data_offer*       offer;
+    GLFWbool                    text_uri_list;
+} _GLFWofferWayland;
+
+// Wayland-specific outgoing clipboard transfer
+//
+typedef struct _GLFWtransferWayland
+{
+    int                         fd;
+    char*                       data;
+    size_t                      size;
+    size_t                      offset;
+} _GLFWtransferWayland;
+
 // Wayland-specific global data
 //
 typedef struct _GLFWlibraryWayland
@@ -229,12 +299,28 @@ typedef struct _GLFWlibraryWayland
     struct wl_subcompositor*    subcompositor;
     struct wl_shell*            shell;
     struct wl_shm*              shm;
+    // Shared memory pool for all cursor and decoration buffers
+    struct {
+        struct wl_shm_pool*     handle;
+        int                     fd;
+        unsigned char*          data;
+        size_t                  size;
+        // Blocks in offset order, together covering the whole pool
+        _GLFWshmBlockWayland*   blocks;
+        int                     blockCount;
+    } shmPool;
     struct wl_seat*             seat;
     struct wl_pointer*          pointer;
     struct wl_keyboard*         keyboard;
     struct wl_data_device_manager*          dataDeviceManager;
     struct wl_data_device*      dataDevice;
     struct wl_data_offer*       dataOffer;
+    // Offers announced but not yet entered or selected
+    _GLFWofferWayland*          offers;
+    int                         offerCount;
+    // Offer of the drag over one of our windows, if it carries paths
+    struct wl_data_offer*       dragOffer;
+    _GLFWwindow*                dragFocus;
     struct wl_data_source*      dataSource;
     struct xdg_wm_base*         wmBase;
     struct zxdg_decoration_manager_v1*      decorationManager;
@@ -242,6 +328,9 @@ typedef struct _GLFWlibraryWayland
     struct zwp_relative_pointer_manager_v1* relativePointerManager;
     struct zwp_pointer_constraints_v1*      pointerConstraints;
     struct zwp_idle_inhibit_manager_v1*     idleInhibitManager;
+    struct wp_presentation*     presentation;
+    // The clock of presentation timestamps, as a clockid_t
+    uint32_t                    presentationClock;
 
     int                         compositorVersion;
     int                         seatVersion;
@@ -261,17 +350,47 @@ typedef struct _GLFWlibraryWayland
     size_t                      clipboardSize;
     char*                       clipboardSendString;
     size_t                      clipboardSendSize;
+    // Asynchronous clipboard request in progress
+    struct {
+        GLFWbool                active;
+        int                     fd;
+        char*                   data;
+        size_t                  size;
+        size_t                  capacity;
+    } clipboardRequest;
+    // Dropped text/uri-list being read, with the whole lines up to the offset
+    // already delivered
+    struct {
+        _GLFWwindow*            window;
+        int                     fd;
+        char*                   data;
+        size_t                  size;
+        size_t                  capacity;
+        size_t                  offset;
+        GLFWbool                delivering;
+    } drop;
+    // Outgoing clipboard transfers waiting for their requestors
+    _GLFWtransferWayland*       transfers;
+    int                         transferCount;
     int                         timerfd;
     short int                   keycodes[256];
     short int                   scancodes[GLFW_KEY_LAST + 1];
+    // Key name strings per cached layout and scancode, filled on first use
+    char                        keynames[_GLFW_KEYNAME_LAYOUTS][256][5];
+    // The layout plus one held by each key name cache slot, or zero if none
+    xkb_layout_index_t          keynameLayouts[_GLFW_KEYNAME_LAYOUTS];
 
     struct {
         void*                   handle;
         struct xkb_context*     context;
         struct xkb_keymap*      keymap;
         struct xkb_state*       state;
+        _GLFWkeymapWayland      keymaps[_GLFW_KEYMAP_CACHE_SIZE];
+        int                     nextKeymap;
 
 #ifdef HAVE_XKBCOMMON_COMPOSE_H
+        // The compose table is only loaded once a key may start a sequence
+        GLFWbool                composeLoaded;
         struct xkb_compose_state* composeState;
 #endif
 
@@ -287,6 +406,7 @@ typedef struct _GLFWlibraryWayland
         PFN_xkb_context_unref context_unref;
         PFN_xkb_keymap_new_from_string keymap_new_from_string;
         PFN_xkb_keymap_unref keymap_unref;
+        PFN_xkb_keymap_ref keymap_ref;
         PFN_xkb_keymap_mod_get_index keymap_mod_get_index;
         PFN_xkb_keymap_key_repeats keymap_key_repeats;
         PFN_xkb_state_new state_new;
@@ -294,6 +414,9 @@ typedef struct _GLFWlibraryWayland
         PFN_xkb_state_key_get_syms state_key_get_syms;
         PFN_xkb_state_update_mask state_update_mask;
         PFN_xkb_state_serialize_mods state_serialize_mods;
+        PFN_xkb_state_serialize_layout state_serialize_layout;
+        PFN_xkb_state_key_get_layout state_key_get_layout;
+        PFN_xkb_keymap_key_get_syms_by_level keymap_key_get_syms_by_level;
 
 #ifdef HAVE_XKBCOMMON_COMPOSE_H
         PFN_xkb_compose_table_new_from_locale compose_table_new_from_locale;
@@ -356,4 +479,6 @@ typedef struct _GLFWcursorWayland
 
 
 void _glfwAddOutputWayland(uint32_t name, uint32_t version);
+void _glfwRequestPresentationFeedbackWayland(_GLFWwindow* window);
+void _glfwReceiveDropWayland(_GLFWwindow* window, struct wl_data_offer* offer);
 
@@ -39,6 +39,11 @@
 #include <sys/mman.h>
 #include <sys/timerfd.h>
 #include <poll.h>
+#include <time.h>
+
+// Number of fds polled without allocating, which covers the display, the
+// timers, a clipboard request, a drop and a few joysticks and transfers
+#define _GLFW_WAYLAND_POLL_FDS 16
 
 
 static void shellSurfaceHandlePing(void* data,
@@ -118,6 +123,19 @@ static int createTmpfileCloexec(char* tmpname)
     return fd;
 }
 
+// Grows the specified anonymous file to the specified size, returning zero or
+// an error number
+//
+static int resizeAnonymousFile(int fd, off_t size)
+{
+#if defined(SHM_ANON)
+    // posix_fallocate does not work on SHM descriptors
+    return ftruncate(fd, size) == 0 ? 0 : errno;
+#else
+    return posix_fallocate(fd, 0, size);
+#endif
+}
+
 /*
  * Create a new, unique, anonymous file of the given size, and
  * return the file descriptor for it. The file descriptor is set
@@ -180,12 +198,7 @@ static int createAnonymousFile(off_t size)
             return -1;
     }
 
-#if defined(SHM_ANON)
-    // posix_fallocate does not work on SHM descriptors
-    ret = ftruncate(fd, size);
-#else
-    ret = posix_fallocate(fd, 0, size);
-#endif
+    ret = resizeAnonymousFile(fd, size);
     if (ret != 0)
     {
         close(fd);
@@ -195,61 +208,258 @@ static int createAnonymousFile(off_t size)
     return fd;
 }
 
-static struct wl_buffer* createShmBuffer(const GLFWimage* image)
+// Inserts a block at the specified index of the shared memory pool
+//
+static GLFWbool insertShmBlock(int index, size_t offset, size_t size)
 {
-    struct wl_shm_pool* pool;
-    struct wl_buffer* buffer;
-    int stride = image->width * 4;
-    int length = image->width * image->height * 4;
-    void* data;
-    int fd, i;
+    _GLFWshmBlockWayland* blocks =
+        realloc(_glfw.wl.shmPool.blocks,
+                sizeof(_GLFWshmBlockWayland) * (_glfw.wl.shmPool.blockCount + 1));
+    if (!blocks)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
 
-    fd = createAnonymousFile(length);
-    if (fd < 0)
+    memmove(blocks + index + 1, blocks + index,
+            sizeof(_GLFWshmBlockWayland) * (_glfw.wl.shmPool.blockCount - index));
+    blocks[index] = (_GLFWshmBlockWayland) { offset, size };
+
+    _glfw.wl.shmPool.blocks = blocks;
+    _glfw.wl.shmPool.blockCount++;
+    return GLFW_TRUE;
+}
+
+// Removes the block at the specified index of the shared memory pool
+//
+static void removeShmBlock(int index)
+{
+    _GLFWshmBlockWayland* blocks = _glfw.wl.shmPool.blocks;
+
+    memmove(blocks + index, blocks + index + 1,
+            sizeof(_GLFWshmBlockWayland) * (_glfw.wl.shmPool.blockCount - index - 1));
+    _glfw.wl.shmPool.blockCount--;
+}
+
+// Grows the shared memory pool so it has a free block of at least the
+// specified size at its end, creating the pool if necessary
+//
+static GLFWbool growShmPool(size_t size)
+{
+    const size_t oldSize = _glfw.wl.shmPool.size;
+    size_t newSize = oldSize ? oldSize * 2 : 65536;
+    while (newSize < oldSize + size)
+        newSize *= 2;
+
+    if (_glfw.wl.shmPool.handle)
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Creating a buffer file for %d B failed: %s",
-                        length, strerror(errno));
-        return NULL;
+        const int error = resizeAnonymousFile(_glfw.wl.shmPool.fd, newSize);
+        if (error)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Growing the buffer file to %zu B failed: %s",
+                            newSize, strerror(error));
+            return GLFW_FALSE;
+        }
+    }
+    else
+    {
+        _glfw.wl.shmPool.fd = createAnonymousFile(newSize);
+        if (_glfw.wl.shmPool.fd < 0)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Creating a buffer file for %zu B failed: %s",
+                            newSize, strerror(errno));
+            return GLFW_FALSE;
+        }
     }
 
-    data = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void* data = mmap(NULL, newSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      _glfw.wl.shmPool.fd, 0);
     if (data == MAP_FAILED)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: mmap failed: %s", strerror(errno));
-        close(fd);
-        return NULL;
+        if (!_glfw.wl.shmPool.handle)
+            close(_glfw.wl.shmPool.fd);
+        return GLFW_FALSE;
+    }
+
+    if (_glfw.wl.shmPool.handle)
+    {
+        munmap(_glfw.wl.shmPool.data, oldSize);
+        wl_shm_pool_resize(_glfw.wl.shmPool.handle, newSize);
+    }
+    else
+    {
+        _glfw.wl.shmPool.handle =
+            wl_shm_create_pool(_glfw.wl.shm, _glfw.wl.shmPool.fd, newSize);
+    }
+
+    _glfw.wl.shmPool.data = data;
+    _glfw.wl.shmPool.size = newSize;
+
+    // The new space joins a trailing free block or becomes one
+    const int last = _glfw.wl.shmPool.blockCount - 1;
+    if (last >= 0 && !_glfw.wl.shmPool.blocks[last].buffer)
+    {
+        _glfw.wl.shmPool.blocks[last].size += newSize - oldSize;
+        return GLFW_TRUE;
+    }
+
+    return insertShmBlock(last + 1, oldSize, newSize - oldSize);
+}
+
+// Finds a free block of at least the specified size in the shared memory pool,
+// growing the pool if there is none, and splits off any excess
+// Returns the index of the block or -1 if an error occurred
+//
+static int allocateShmBlock(size_t size)
+{
+    // Keep offsets aligned for any pixel format
+    size = (size + 15) & ~(size_t) 15;
+
+    int index = -1;
+
+    for (int i = 0;  i < _glfw.wl.shmPool.blockCount;  i++)
+    {
+        const _GLFWshmBlockWayland* block = _glfw.wl.shmPool.blocks + i;
+        if (!block->buffer && block->size >= size)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == -1)
+    {
+        if (!growShmPool(size))
+            return -1;
+
+        index = _glfw.wl.shmPool.blockCount - 1;
+    }
+
+    _GLFWshmBlockWayland* block = _glfw.wl.shmPool.blocks + index;
+    if (block->size > size)
+    {
+        const size_t offset = block->offset + size;
+        const size_t excess = block->size - size;
+
+        block->size = size;
+        if (!insertShmBlock(index + 1, offset, excess))
+            _glfw.wl.shmPool.blocks[index].size += excess;
+    }
+
+    return index;
+}
+
+// Returns the index of the shared memory pool block of the specified buffer,
+// or -1 if the buffer is not from the pool
+//
+static int findShmBlock(struct wl_buffer* buffer)
+{
+    for (int i = 0;  i < _glfw.wl.shmPool.blockCount;  i++)
+    {
+        if (_glfw.wl.shmPool.blocks[i].buffer == buffer)
+            return i;
     }
 
-    pool = wl_shm_create_pool(_glfw.wl.shm, fd, length);
+    return -1;
+}
+
+// Destroys the buffer of the specified block and merges the block with any
+// adjacent free blocks
+//
+static void freeShmBlock(int index)
+{
+    _GLFWshmBlockWayland* blocks = _glfw.wl.shmPool.blocks;
+
+    wl_buffer_destroy(blocks[index].buffer);
+    blocks[index] = (_GLFWshmBlockWayland) { blocks[index].offset,
+                                             blocks[index].size };
 
-    close(fd);
-    unsigned char* source = (unsigned char*) image->pixels;
-    unsigned char* target = data;
-    for (i = 0;  i < image->width * image->height;  i++, source += 4)
+    if (index + 1 < _glfw.wl.shmPool.blockCount && !blocks[index + 1].buffer)
     {
-        unsigned int alpha = source[3];
+        blocks[index].size += blocks[index + 1].size;
+        removeShmBlock(index + 1);
+    }
 
-        *target++ = (unsigned char) ((source[2] * alpha) / 255);
-        *target++ = (unsigned char) ((source[1] * alpha) / 255);
-        *target++ = (unsigned char) ((source[0] * alpha) / 255);
-        *target++ = (unsigned char) alpha;
+    if (index > 0 && !blocks[index - 1].buffer)
+    {
+        blocks[index - 1].size += blocks[index].size;
+        removeShmBlock(index);
     }
+}
+
+static void bufferHandleRelease(void* userData, struct wl_buffer* buffer)
+{
+    const int index = findShmBlock(buffer);
+    if (index == -1)
+        return;
+
+    _glfw.wl.shmPool.blocks[index].busy = GLFW_FALSE;
+
+    // The block can only be reused once the compositor is done reading it
+    if (_glfw.wl.shmPool.blocks[index].retired)
+        freeShmBlock(index);
+}
+
+static const struct wl_buffer_listener bufferListener = {
+    bufferHandleRelease
+};
+
+static struct wl_buffer* createShmBuffer(const GLFWimage* image, int format)
+{
+    const int stride = image->width * 4;
+    const int index = allocateShmBlock((size_t) stride * image->height);
+    if (index == -1)
+        return NULL;
+
+    _GLFWshmBlockWayland* block = _glfw.wl.shmPool.blocks + index;
+
+    // ARGB8888 is little-endian premultiplied ARGB, i.e. BGRA in memory
+    _glfwConvertImage(image, format, _GLFW_PIXELS_BGRA, GLFW_TRUE,
+                      _glfw.wl.shmPool.data + block->offset);
 
-    buffer =
-        wl_shm_pool_create_buffer(pool, 0,
+    block->buffer =
+        wl_shm_pool_create_buffer(_glfw.wl.shmPool.handle,
+                                  (int32_t) block->offset,
                                   image->width,
                                   image->height,
                                   stride, WL_SHM_FORMAT_ARGB8888);
-    munmap(data, length);
-    wl_shm_pool_destroy(pool);
+    wl_buffer_add_listener(block->buffer, &bufferListener, NULL);
+    return block->buffer;
+}
+
+// Attaches the specified buffer to the specified surface, noting that the
+// compositor may read it if it is from the shared memory pool
+//
+static void attachBuffer(struct wl_surface* surface, struct wl_buffer* buffer)
+{
+    const int index = findShmBlock(buffer);
+    if (index != -1)
+        _glfw.wl.shmPool.blocks[index].busy = GLFW_TRUE;
+
+    wl_surface_attach(surface, buffer, 0, 0);
+}
+
+// Releases a buffer created with createShmBuffer, recycling its block once the
+// compositor no longer uses it
+//
+static void destroyShmBuffer(struct wl_buffer* buffer)
+{
+    const int index = findShmBlock(buffer);
+    if (index == -1)
+        return;
 
-    return buffer;
+    if (_glfw.wl.shmPool.blocks[index].busy)
+        _glfw.wl.shmPool.blocks[index].retired = GLFW_TRUE;
+    else
+        freeShmBlock(index);
 }
 
-static void createDecoration(_GLFWdecorationWayland* decoration,
-                             struct wl_surface* parent,
+static void createDecoration(_GLFWwindow* window,
+                             _GLFWdecorationWayland* decoration,
                              struct wl_buffer* buffer, GLFWbool opaque,
                              int x, int y,
                              int width, int height)
@@ -257,14 +467,16 @@ static void createDecoration(_GLFWdecorationWayland* decoration,
     struct wl_region* region;
 
     decoration->surface = wl_compositor_create_surface(_glfw.wl.compositor);
+    // Decoration surfaces are tagged with their window like the main surface
+    wl_surface_set_user_data(decoration->surface, window);
     decoration->subsurface =
         wl_subcompositor_get_subsurface(_glfw.wl.subcompositor,
-                                        decoration->surface, parent);
+                                        decoration->surface, window->wl.surface);
     wl_subsurface_set_position(decoration->subsurface, x, y);
     decoration->viewport = wp_viewporter_get_viewport(_glfw.wl.viewporter,
                                                       decoration->surface);
     wp_viewport_set_destination(decoration->viewport, width, height);
-    wl_surface_attach(decoration->surface, buffer, 0, 0);
+    attachBuffer(decoration->surface, buffer);
 
     if (opaque)
     {
@@ -288,23 +500,26 @@ static void createDecorations(_GLFWwindow* window)
         return;
 
     if (!window->wl.decorations.buffer)
-        window->wl.decorations.buffer = createShmBuffer(&image);
+    {
+        window->wl.decorations.buffer =
+            createShmBuffer(&image, GLFW_IMAGE_RGBA);
+    }
     if (!window->wl.decorations.buffer)
         return;
 
-    createDecoration(&window->wl.decorations.top, window->wl.surface,
+    createDecoration(window, &window->wl.decorations.top,
                      window->wl.decorations.buffer, opaque,
                      0, -_GLFW_DECORATION_TOP,
                      window->wl.width, _GLFW_DECORATION_TOP);
-    createDecoration(&window->wl.decorations.left, window->wl.surface,
+    createDecoration(window, &window->wl.decorations.left,
                      window->wl.decorations.buffer, opaque,
                      -_GLFW_DECORATION_WIDTH, -_GLFW_DECORATION_TOP,
                      _GLFW_DECORATION_WIDTH, window->wl.height + _GLFW_DECORATION_TOP);
-    createDecoration(&window->wl.decorations.right, window->wl.surface,
+    createDecoration(window, &window->wl.decorations.right,
                      window->wl.decorations.buffer, opaque,
                      window->wl.width, -_GLFW_DECORATION_TOP,
                      _GLFW_DECORATION_WIDTH, window->wl.height + _GLFW_DECORATION_TOP);
-    createDecoration(&window->wl.decorations.bottom, window->wl.surface,
+    createDecoration(window, &window->wl.decorations.bottom,
                      window->wl.decorations.buffer, opaque,
                      -_GLFW_DECORATION_WIDTH, window->wl.height,
                      window->wl.width + _GLFW_DECORATION_HORIZONTAL, _GLFW_DECORATION_WIDTH);
@@ -363,12 +578,50 @@ static void setOpaqueRegion(_GLFWwindow* window)
 }
 
 
+// Returns the size of the framebuffer for the current window size, content
+// scale and render scale
+//
+static void getFramebufferSize(_GLFWwindow* window, int* width, int* height)
+{
+    *width = window->wl.width * window->wl.scale;
+    *height = window->wl.height * window->wl.scale;
+
+    if (window->wl.renderScale != 1.f)
+    {
+        *width = (int) (*width * window->wl.renderScale + 0.5f);
+        *height = (int) (*height * window->wl.renderScale + 0.5f);
+        if (*width < 1)
+            *width = 1;
+        if (*height < 1)
+            *height = 1;
+    }
+}
+
+// Sets the buffer scale of the window surface, which must be one while its
+// viewport scales the framebuffer to a size that need not be a multiple
+//
+static void setBufferScale(_GLFWwindow* window)
+{
+    if (_glfw.wl.compositorVersion < 3)
+        return;
+
+    if (window->wl.renderScale != 1.f)
+        wl_surface_set_buffer_scale(window->wl.surface, 1);
+    else
+        wl_surface_set_buffer_scale(window->wl.surface, window->wl.scale);
+}
+
 static void resizeWindow(_GLFWwindow* window)
 {
     int scale = window->wl.scale;
-    int scaledWidth = window->wl.width * scale;
-    int scaledHeight = window->wl.height * scale;
+    int scaledWidth, scaledHeight;
+    getFramebufferSize(window, &scaledWidth, &scaledHeight);
     wl_egl_window_resize(window->wl.native, scaledWidth, scaledHeight, 0, 0);
+    if (window->wl.renderScale != 1.f)
+    {
+        wp_viewport_set_destination(window->wl.viewport,
+                                    window->wl.width, window->wl.height);
+    }
     if (!window->wl.transparent)
         setOpaqueRegion(window);
     _glfwInputFramebufferSize(window, scaledWidth, scaledHeight);
@@ -424,7 +677,7 @@ static void checkScaleChange(_GLFWwindow* window)
     if (scale != window->wl.scale)
     {
         window->wl.scale = scale;
-        wl_surface_set_buffer_scale(window->wl.surface, scale);
+        setBufferScale(window);
         resizeWindow(window);
     }
 }
@@ -475,6 +728,113 @@ static const struct wl_surface_listener surfaceListener = {
     surfaceHandleLeave
 };
 
+static void frameHandleDone(void* data,
+                            struct wl_callback* callback,
+                            uint32_t time);
+
+static const struct wl_callback_listener frameListener = {
+    frameHandleDone
+};
+
+// Asks the compositor to tell us when it is a good time to draw the window
+// The request takes effect with the next commit of the surface
+//
+static void requestFrame(_GLFWwindow* window)
+{
+    if (window->wl.frameCallback)
+        return;
+
+    window->wl.frameCallback = wl_surface_frame(window->wl.surface);
+    wl_callback_add_listener(window->wl.frameCallback, &frameListener, window);
+}
+
+static void frameHandleDone(void* data,
+                            struct wl_callback* callback,
+                            uint32_t time)
+{
+    _GLFWwindow* window = data;
+
+    wl_callback_destroy(callback);
+    window->wl.frameCallback = NULL;
+
+    if (!window->callbacks.frame)
+        return;
+
+    // The next request is committed by presenting the frame drawn in response
+    // to this one, so no callbacks arrive for a window that is not redrawn
+    requestFrame(window);
+    _glfwInputWindowFrame(window);
+}
+
+// Forgets the specified presentation feedback once it has been reported
+//
+static void removeFeedback(_GLFWwindow* window,
+                           struct wp_presentation_feedback* feedback)
+{
+    for (int i = 0;  i < window->wl.feedbackCount;  i++)
+    {
+        if (window->wl.feedbacks[i] == feedback)
+        {
+            window->wl.feedbacks[i] =
+                window->wl.feedbacks[--window->wl.feedbackCount];
+            break;
+        }
+    }
+
+    wp_presentation_feedback_destroy(feedback);
+}
+
+static void feedbackHandleSyncOutput(void* data,
+                                     struct wp_presentation_feedback* feedback,
+                                     struct wl_output* output)
+{
+}
+
+static void feedbackHandlePresented(void* data,
+                                    struct wp_presentation_feedback* feedback,
+                                    uint32_t secondsHigh,
+                                    uint32_t secondsLow,
+                                    uint32_t nanoseconds,
+                                    uint32_t refresh,
+                                    uint32_t sequenceHigh,
+                                    uint32_t sequenceLow,
+                                    uint32_t flags)
+{
+    _GLFWwindow* window = data;
+    const int64_t seconds = ((int64_t) secondsHigh << 32) | secondsLow;
+    uint64_t sequence = 0;
+    struct timespec now;
+
+    // Move the timestamp into the GLFW timer domain by its age, as the
+    // presentation clock need not be the one used by the timer
+    const uint64_t timerNow = _glfwPlatformGetTimerValue();
+    clock_gettime((clockid_t) _glfw.wl.presentationClock, &now);
+
+    const int64_t age = (now.tv_sec - seconds) * 1000000000 +
+                        ((int64_t) now.tv_nsec - nanoseconds);
+    const uint64_t frequency = _glfwPlatformGetTimerFrequency();
+    const uint64_t time = timerNow -
+        (int64_t) ((double) age * frequency / 1000000000.0);
+
+    if (flags & WP_PRESENTATION_FEEDBACK_KIND_HW_COUNTER)
+        sequence = ((uint64_t) sequenceHigh << 32) | sequenceLow;
+
+    removeFeedback(window, feedback);
+    _glfwInputWindowPresentation(window, time, refresh / 1e9, sequence);
+}
+
+static void feedbackHandleDiscarded(void* data,
+                                    struct wp_presentation_feedback* feedback)
+{
+    removeFeedback(data, feedback);
+}
+
+static const struct wp_presentation_feedback_listener feedbackListener = {
+    feedbackHandleSyncOutput,
+    feedbackHandlePresented,
+    feedbackHandleDiscarded
+};
+
 static void setIdleInhibitor(_GLFWwindow* window, GLFWbool enable)
 {
     if (enable && !window->wl.idleInhibitor && _glfw.wl.idleInhibitManager)
@@ -515,6 +875,7 @@ static GLFWbool createSurface(_GLFWwindow* window,
     window->wl.width = wndconfig->width;
     window->wl.height = wndconfig->height;
     window->wl.scale = 1;
+    window->wl.renderScale = 1.f;
 
     if (!window->wl.transparent)
         setOpaqueRegion(window);
@@ -801,7 +1162,7 @@ static void setCursorImage(_GLFWwindow* window,
                           cursorWayland->xhot / scale,
                           cursorWayland->yhot / scale);
     wl_surface_set_buffer_scale(surface, scale);
-    wl_surface_attach(surface, buffer, 0, 0);
+    attachBuffer(surface, buffer);
     wl_surface_damage(surface, 0, 0,
                       cursorWayland->width, cursorWayland->height);
     wl_surface_commit(surface);
@@ -823,20 +1184,360 @@ static void incrementCursorImage(_GLFWwindow* window)
     }
 }
 
+// Ends the asynchronous clipboard request and delivers its result
+//
+static void endClipboardRequest(char* string)
+{
+    close(_glfw.wl.clipboardRequest.fd);
+    memset(&_glfw.wl.clipboardRequest, 0, sizeof(_glfw.wl.clipboardRequest));
+
+    _glfwInputClipboardString(string);
+    free(string);
+}
+
+// Reads what is available from the asynchronous clipboard request pipe and
+// delivers the result once the source has closed it
+//
+static void readClipboardRequest(void)
+{
+    for (;;)
+    {
+        if (_glfw.wl.clipboardRequest.size + 4096 + 1 >
+            _glfw.wl.clipboardRequest.capacity)
+        {
+            const size_t capacity = _glfw.wl.clipboardRequest.capacity * 2 + 4096;
+            char* data = realloc(_glfw.wl.clipboardRequest.data, capacity);
+            if (!data)
+            {
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                endClipboardRequest(NULL);
+                return;
+            }
+
+            _glfw.wl.clipboardRequest.data = data;
+            _glfw.wl.clipboardRequest.capacity = capacity;
+        }
+
+        char* data = _glfw.wl.clipboardRequest.data;
+        const size_t size = _glfw.wl.clipboardRequest.size;
+        const ssize_t result = read(_glfw.wl.clipboardRequest.fd,
+                                    data + size,
+                                    _glfw.wl.clipboardRequest.capacity - size - 1);
+        if (result > 0)
+        {
+            _glfw.wl.clipboardRequest.size += result;
+            continue;
+        }
+
+        if (result == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN)
+                return;
+
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Failed to read from clipboard fd");
+            endClipboardRequest(NULL);
+            return;
+        }
+
+        // The source has written all the data
+        data[size] = '\0';
+        _glfw.wl.clipboardRequest.data = NULL;
+        endClipboardRequest(data);
+        return;
+    }
+}
+
+// Abandons the read of the dropped text/uri-list without delivering anything
+//
+static void cancelDrop(void)
+{
+    close(_glfw.wl.drop.fd);
+    free(_glfw.wl.drop.data);
+    memset(&_glfw.wl.drop, 0, sizeof(_glfw.wl.drop));
+}
+
+// Ends the read of the dropped text/uri-list and delivers the lines not yet
+// delivered as the last part
+//
+static void endDrop(GLFWbool complete)
+{
+    _GLFWwindow* window = _glfw.wl.drop.window;
+    char* data = _glfw.wl.drop.data;
+    size_t size = _glfw.wl.drop.size;
+    const size_t offset = _glfw.wl.drop.offset;
+    char empty = '\0';
+
+    close(_glfw.wl.drop.fd);
+    memset(&_glfw.wl.drop, 0, sizeof(_glfw.wl.drop));
+
+    if (data)
+    {
+        // A list that was cut short loses its partial last line
+        if (!complete)
+        {
+            while (size > offset && data[size - 1] != '\n')
+                size--;
+        }
+
+        data[size] = '\0';
+    }
+
+    _glfwInputDropUriList(window, data ? data + offset : &empty, GLFW_TRUE);
+    free(data);
+}
+
+// Reads what is available of the dropped text/uri-list, delivering whole
+// lines as they arrive if the window streams its drops
+//
+static void readDrop(void)
+{
+    for (;;)
+    {
+        if (_glfw.wl.drop.size + 4096 + 1 > _glfw.wl.drop.capacity)
+        {
+            // Delivered lines are discarded first, so the buffer only grows
+            // with the part not yet delivered
+            if (_glfw.wl.drop.offset)
+            {
+                memmove(_glfw.wl.drop.data,
+                        _glfw.wl.drop.data + _glfw.wl.drop.offset,
+                        _glfw.wl.drop.size - _glfw.wl.drop.offset);
+                _glfw.wl.drop.size -= _glfw.wl.drop.offset;
+                _glfw.wl.drop.offset = 0;
+            }
+        }
+
+        if (_glfw.wl.drop.size + 4096 + 1 > _glfw.wl.drop.capacity)
+        {
+            const size_t capacity = _glfw.wl.drop.capacity * 2 + 4096;
+            char* data = realloc(_glfw.wl.drop.data, capacity);
+            if (!data)
+            {
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                endDrop(GLFW_FALSE);
+                return;
+            }
+
+            _glfw.wl.drop.data = data;
+            _glfw.wl.drop.capacity = capacity;
+        }
+
+        const size_t size = _glfw.wl.drop.size;
+        const ssize_t result = read(_glfw.wl.drop.fd,
+                                    _glfw.wl.drop.data + size,
+                                    _glfw.wl.drop.capacity - size - 1);
+        if (result > 0)
+        {
+            _glfw.wl.drop.size += result;
+            continue;
+        }
+
+        if (result == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN)
+                break;
+
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Failed to read from drop fd: %s",
+                            strerror(errno));
+            endDrop(GLFW_FALSE);
+            return;
+        }
+
+        // The source has written the whole list
+        endDrop(GLFW_TRUE);
+        return;
+    }
+
+    _GLFWwindow* window = _glfw.wl.drop.window;
+    if (!window->callbacks.dropStream)
+        return;
+
+    char* data = _glfw.wl.drop.data;
+    const size_t offset = _glfw.wl.drop.offset;
+    size_t end = _glfw.wl.drop.size;
+
+    while (end > offset && data[end - 1] != '\n')
+        end--;
+
+    if (end == offset)
+        return;
+
+    data[end - 1] = '\0';
+    _glfw.wl.drop.offset = end;
+
+    // The buffer must stay put while it is being parsed, so nested event
+    // processing leaves the drop alone until the callback returns
+    _glfw.wl.drop.delivering = GLFW_TRUE;
+    _glfwInputDropUriList(window, data + offset, GLFW_FALSE);
+    _glfw.wl.drop.delivering = GLFW_FALSE;
+
+    // The window may have been destroyed by the callback
+    if (!_glfw.wl.drop.window)
+        cancelDrop();
+}
+
+// Writes as much of the specified outgoing transfer as the requestor currently
+// accepts, returning whether the transfer has ended
+//
+static GLFWbool writeTransfer(_GLFWtransferWayland* transfer)
+{
+    while (transfer->offset < transfer->size)
+    {
+        const ssize_t result = write(transfer->fd,
+                                     transfer->data + transfer->offset,
+                                     transfer->size - transfer->offset);
+        if (result == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return GLFW_FALSE;
+
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Error while writing the clipboard: %s",
+                            strerror(errno));
+            return GLFW_TRUE;
+        }
+
+        transfer->offset += result;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Removes the specified outgoing transfer and closes its pipe
+//
+static void removeTransfer(int index)
+{
+    close(_glfw.wl.transfers[index].fd);
+    free(_glfw.wl.transfers[index].data);
+    _glfw.wl.transfers[index] = _glfw.wl.transfers[--_glfw.wl.transferCount];
+}
+
+// Writes as much of every outgoing transfer as their requestors accept
+//
+static void writeTransfers(void)
+{
+    for (int i = _glfw.wl.transferCount - 1;  i >= 0;  i--)
+    {
+        if (writeTransfer(_glfw.wl.transfers + i))
+            removeTransfer(i);
+    }
+}
+
+// Starts sending the specified data to the requestor pipe without blocking,
+// keeping a copy of whatever it does not accept right away
+//
+static void sendTransfer(int fd, const char* data, size_t size)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    _GLFWtransferWayland transfer = { fd, (char*) data, size, 0 };
+    if (writeTransfer(&transfer))
+    {
+        close(fd);
+        return;
+    }
+
+    // The remaining data is copied as the clipboard may change or the provided
+    // data go away before the requestor has read it
+    const size_t remaining = transfer.size - transfer.offset;
+    char* copy = malloc(remaining);
+    _GLFWtransferWayland* transfers =
+        realloc(_glfw.wl.transfers,
+                sizeof(_GLFWtransferWayland) * (_glfw.wl.transferCount + 1));
+    if (!copy || !transfers)
+    {
+        if (transfers)
+            _glfw.wl.transfers = transfers;
+
+        free(copy);
+        close(fd);
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return;
+    }
+
+    memcpy(copy, data + transfer.offset, remaining);
+
+    _glfw.wl.transfers = transfers;
+    _glfw.wl.transfers[_glfw.wl.transferCount++] =
+        (_GLFWtransferWayland) { fd, copy, remaining, 0 };
+}
+
 static void handleEvents(int timeout)
 {
     struct wl_display* display = _glfw.wl.display;
-    struct pollfd fds[] = {
-        { wl_display_get_fd(display), POLLIN },
-        { _glfw.wl.timerfd, POLLIN },
-        { _glfw.wl.cursorTimerfd, POLLIN },
-    };
+    const int* joystickFds = NULL;
+    int joystickCount = 0;
     ssize_t read_ret;
     uint64_t repeats, i;
 
+    // Callbacks dispatched here may add or complete transfers and clipboard
+    // requests, so the fds to poll are only gathered afterwards
     while (wl_display_prepare_read(display) != 0)
         wl_display_dispatch_pending(display);
 
+#if defined(__linux__)
+    if (_glfw.joysticksInitialized)
+        joystickFds = _glfwGetJoystickFdsLinux(&joystickCount);
+#endif
+
+    int transferCount = _glfw.wl.transferCount;
+
+    // The poll array is owned by this call, as callbacks dispatched below may
+    // call this function again, e.g. by retrieving the clipboard
+    // Only unusually many joysticks or transfers need a heap array
+    struct pollfd stackFds[_GLFW_WAYLAND_POLL_FDS];
+    struct pollfd* fds = stackFds;
+    const int fdCount = 5 + joystickCount + transferCount;
+
+    if (fdCount > _GLFW_WAYLAND_POLL_FDS)
+    {
+        fds = calloc(fdCount, sizeof(struct pollfd));
+        if (!fds)
+        {
+            // Poll what fits, the rest is handled by a later call
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            fds = stackFds;
+            if (joystickCount > _GLFW_WAYLAND_POLL_FDS - 5)
+                joystickCount = _GLFW_WAYLAND_POLL_FDS - 5;
+            if (transferCount > _GLFW_WAYLAND_POLL_FDS - 5 - joystickCount)
+                transferCount = _GLFW_WAYLAND_POLL_FDS - 5 - joystickCount;
+        }
+    }
+
+    fds[0] = (struct pollfd) { wl_display_get_fd(display), POLLIN };
+    fds[1] = (struct pollfd) { _glfw.wl.timerfd, POLLIN };
+    fds[2] = (struct pollfd) { _glfw.wl.cursorTimerfd, POLLIN };
+    nfds_t count = 3;
+
+    for (int j = 0;  j < joystickCount;  j++)
+        fds[count++] = (struct pollfd) { joystickFds[j], POLLIN };
+
+    nfds_t clipboardIndex = 0;
+    if (_glfw.wl.clipboardRequest.active)
+    {
+        clipboardIndex = count;
+        fds[count++] = (struct pollfd) { _glfw.wl.clipboardRequest.fd, POLLIN };
+    }
+
+    nfds_t dropIndex = 0;
+    if (_glfw.wl.drop.window && !_glfw.wl.drop.delivering)
+    {
+        dropIndex = count;
+        fds[count++] = (struct pollfd) { _glfw.wl.drop.fd, POLLIN };
+    }
+
+    const nfds_t transferIndex = count;
+    for (int j = 0;  j < transferCount;  j++)
+        fds[count++] = (struct pollfd) { _glfw.wl.transfers[j].fd, POLLOUT };
+
     // If an error different from EAGAIN happens, we have likely been
     // disconnected from the Wayland session, try to handle that the best we
     // can.
@@ -849,11 +1550,29 @@ static void handleEvents(int timeout)
             window = window->next;
         }
         wl_display_cancel_read(display);
+
+        if (fds != stackFds)
+            free(fds);
+
         return;
     }
 
-    if (poll(fds, 3, timeout) > 0)
+    if (poll(fds, count, timeout) > 0)
     {
+        // Transfers are written before dispatching, as callbacks may change
+        // the transfer list
+        for (int j = transferCount - 1;  j >= 0;  j--)
+        {
+            const short revents = fds[transferIndex + j].revents;
+
+            // An error means the requestor has closed its end of the pipe
+            if ((revents & POLLERR) ||
+                ((revents & POLLOUT) && writeTransfer(_glfw.wl.transfers + j)))
+            {
+                removeTransfer(j);
+            }
+        }
+
         if (fds[0].revents & POLLIN)
         {
             wl_display_read_events(display);
@@ -864,31 +1583,55 @@ static void handleEvents(int timeout)
             wl_display_cancel_read(display);
         }
 
+        // The timers are non-blocking, as a nested call from a callback above
+        // may already have read them
         if (fds[1].revents & POLLIN)
         {
             read_ret = read(_glfw.wl.timerfd, &repeats, sizeof(repeats));
-            if (read_ret != 8)
-                return;
-
-            for (i = 0; i < repeats; ++i)
-                _glfwInputKey(_glfw.wl.keyboardFocus, _glfw.wl.keyboardLastKey,
-                              _glfw.wl.keyboardLastScancode, GLFW_REPEAT,
-                              _glfw.wl.xkb.modifiers);
+            if (read_ret == 8)
+            {
+                for (i = 0; i < repeats; ++i)
+                    _glfwInputKey(_glfw.wl.keyboardFocus, _glfw.wl.keyboardLastKey,
+                                  _glfw.wl.keyboardLastScancode, GLFW_REPEAT,
+                                  _glfw.wl.xkb.modifiers);
+            }
         }
 
         if (fds[2].revents & POLLIN)
         {
             read_ret = read(_glfw.wl.cursorTimerfd, &repeats, sizeof(repeats));
-            if (read_ret != 8)
-                return;
+            if (read_ret == 8)
+                incrementCursorImage(_glfw.wl.pointerFocus);
+        }
+
+        // A nested call may also have completed the clipboard request
+        if (clipboardIndex && _glfw.wl.clipboardRequest.active &&
+            (fds[clipboardIndex].revents & (POLLIN | POLLHUP | POLLERR)))
+        {
+            readClipboardRequest();
+        }
 
-            incrementCursorImage(_glfw.wl.pointerFocus);
+        if (dropIndex && _glfw.wl.drop.window && !_glfw.wl.drop.delivering &&
+            (fds[dropIndex].revents & (POLLIN | POLLHUP | POLLERR)))
+        {
+            readDrop();
         }
     }
     else
     {
         wl_display_cancel_read(display);
     }
+
+    if (fds != stackFds)
+        free(fds);
+
+#if defined(__linux__)
+    if (_glfw.joysticksInitialized)
+    {
+        _glfwDetectJoystickConnectionLinux();
+        _glfwPollJoysticksLinux();
+    }
+#endif
 }
 
 // Translates a GLFW standard cursor to a theme cursor name
@@ -913,6 +1656,97 @@ static char *translateCursorShape(int shape)
     return NULL;
 }
 
+// Fills the specified key name cache slot for the specified layout
+//
+static void updateKeyNames(unsigned int slot, xkb_layout_index_t layout)
+{
+    memset(_glfw.wl.keynames[slot], 0, sizeof(_glfw.wl.keynames[slot]));
+
+    for (int scancode = 0;  scancode < 256;  scancode++)
+    {
+        if (_glfw.wl.keycodes[scancode] == GLFW_KEY_UNKNOWN)
+            continue;
+
+        // The keymap may have fewer layouts for this key than are active
+        const xkb_keycode_t code = scancode + 8;
+        const xkb_layout_index_t keyLayout =
+            xkb_state_key_get_layout(_glfw.wl.xkb.state, code);
+        if (keyLayout == XKB_LAYOUT_INVALID)
+            continue;
+
+        const xkb_keysym_t* syms;
+        if (xkb_keymap_key_get_syms_by_level(_glfw.wl.xkb.keymap,
+                                             code, keyLayout, 0, &syms) != 1)
+        {
+            continue;
+        }
+
+        const long ch = _glfwKeySym2Unicode(syms[0]);
+        if (ch == -1)
+            continue;
+
+        char* name = _glfw.wl.keynames[slot][scancode];
+        name[_glfwEncodeUTF8(name, (unsigned int) ch)] = '\0';
+    }
+
+    _glfw.wl.keynameLayouts[slot] = layout + 1;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+void _glfwRequestPresentationFeedbackWayland(_GLFWwindow* window)
+{
+    if (!_glfw.wl.presentation)
+        return;
+
+    struct wp_presentation_feedback** feedbacks =
+        realloc(window->wl.feedbacks,
+                sizeof(struct wp_presentation_feedback*) *
+                (window->wl.feedbackCount + 1));
+    if (!feedbacks)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return;
+    }
+
+    window->wl.feedbacks = feedbacks;
+    window->wl.feedbacks[window->wl.feedbackCount] =
+        wp_presentation_feedback(_glfw.wl.presentation, window->wl.surface);
+    wp_presentation_feedback_add_listener(window->wl.feedbacks[window->wl.feedbackCount],
+                                          &feedbackListener,
+                                          window);
+    window->wl.feedbackCount++;
+}
+
+void _glfwReceiveDropWayland(_GLFWwindow* window, struct wl_data_offer* offer)
+{
+    int fds[2];
+
+    // Only one dropped list is read at a time
+    if (_glfw.wl.drop.window)
+        return;
+
+    if (pipe2(fds, O_CLOEXEC) < 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create drop pipe: %s",
+                        strerror(errno));
+        return;
+    }
+
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    wl_data_offer_receive(offer, "text/uri-list", fds[1]);
+    close(fds[1]);
+
+    _glfw.wl.drop.window = window;
+    _glfw.wl.drop.fd = fds[0];
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -983,6 +1817,20 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 
 void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
+    if (window == _glfw.wl.dragFocus)
+    {
+        wl_data_offer_destroy(_glfw.wl.dragOffer);
+        _glfw.wl.dragOffer = NULL;
+        _glfw.wl.dragFocus = NULL;
+    }
+    if (window == _glfw.wl.drop.window)
+    {
+        // A drop being delivered is cancelled once its callback returns
+        if (_glfw.wl.drop.delivering)
+            _glfw.wl.drop.window = NULL;
+        else
+            cancelDrop();
+    }
     if (window == _glfw.wl.pointerFocus)
     {
         _glfw.wl.pointerFocus = NULL;
@@ -997,6 +1845,13 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
     if (window->wl.idleInhibitor)
         zwp_idle_inhibitor_v1_destroy(window->wl.idleInhibitor);
 
+    if (window->wl.frameCallback)
+        wl_callback_destroy(window->wl.frameCallback);
+
+    for (int i = 0;  i < window->wl.feedbackCount;  i++)
+        wp_presentation_feedback_destroy(window->wl.feedbacks[i]);
+    free(window->wl.feedbacks);
+
     if (window->context.destroy)
         window->context.destroy(window);
 
@@ -1005,7 +1860,7 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
         zxdg_toplevel_decoration_v1_destroy(window->wl.xdg.decoration);
 
     if (window->wl.decorations.buffer)
-        wl_buffer_destroy(window->wl.decorations.buffer);
+        destroyShmBuffer(window->wl.decorations.buffer);
 
     if (window->wl.native)
         wl_egl_window_destroy(window->wl.native);
@@ -1019,6 +1874,9 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
     if (window->wl.xdg.surface)
         xdg_surface_destroy(window->wl.xdg.surface);
 
+    if (window->wl.viewport)
+        wp_viewport_destroy(window->wl.viewport);
+
     if (window->wl.surface)
         wl_surface_destroy(window->wl.surface);
 
@@ -1110,9 +1968,7 @@ void _glfwPlatformSetWindowAspectRatio(_GLFWwindow* window,
 void _glfwPlatformGetFramebufferSize(_GLFWwindow* window,
                                      int* width, int* height)
 {
-    _glfwPlatformGetWindowSize(window, width, height);
-    *width *= window->wl.scale;
-    *height *= window->wl.scale;
+    getFramebufferSize(window, width, height);
 }
 
 void _glfwPlatformGetWindowFrameSize(_GLFWwindow* window,
@@ -1225,6 +2081,15 @@ void _glfwPlatformRequestWindowAttention(_GLFWwindow* window)
                     "Wayland: Window attention request not implemented yet");
 }
 
+void _glfwPlatformRequestWindowFrame(_GLFWwindow* window)
+{
+    if (window->wl.frameCallback)
+        return;
+
+    requestFrame(window);
+    wl_surface_commit(window->wl.surface);
+}
+
 void _glfwPlatformFocusWindow(_GLFWwindow* window)
 {
     _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -1320,6 +2185,36 @@ void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity)
 {
 }
 
+void _glfwPlatformSetWindowRenderScale(_GLFWwindow* window, float scale)
+{
+    if (scale == window->wl.renderScale)
+        return;
+
+    if (!window->wl.viewport)
+    {
+        if (!_glfw.wl.viewporter)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Render scaling requires the viewporter protocol");
+            return;
+        }
+
+        window->wl.viewport =
+            wp_viewporter_get_viewport(_glfw.wl.viewporter, window->wl.surface);
+    }
+
+    window->wl.renderScale = scale;
+
+    // The viewport only scales the framebuffer when it is not the default size
+    // The new buffer scale, viewport and buffer size are all applied together
+    // by the commit of the next frame
+    if (scale == 1.f)
+        wp_viewport_set_destination(window->wl.viewport, -1, -1);
+
+    setBufferScale(window);
+    resizeWindow(window);
+}
+
 void _glfwPlatformSetRawMouseMotion(_GLFWwindow *window, GLFWbool enabled)
 {
     // This is handled in relativePointerHandleRelativeMotion
@@ -1330,6 +2225,10 @@ GLFWbool _glfwPlatformRawMouseMotionSupported(void)
     return GLFW_TRUE;
 }
 
+void _glfwPlatformUpdateTextInput(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformPollEvents(void)
 {
     handleEvents(0);
@@ -1378,8 +2277,27 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
 
 const char* _glfwPlatformGetScancodeName(int scancode)
 {
-    // TODO
-    return NULL;
+    if (scancode < 0 || scancode > 255 ||
+        _glfw.wl.keycodes[scancode] == GLFW_KEY_UNKNOWN)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid scancode");
+        return NULL;
+    }
+
+    if (!_glfw.wl.xkb.keymap)
+        return NULL;
+
+    const xkb_layout_index_t layout =
+        xkb_state_serialize_layout(_glfw.wl.xkb.state,
+                                   XKB_STATE_LAYOUT_EFFECTIVE);
+    const unsigned int slot = layout % _GLFW_KEYNAME_LAYOUTS;
+    if (_glfw.wl.keynameLayouts[slot] != layout + 1)
+        updateKeyNames(slot, layout);
+
+    if (_glfw.wl.keynames[slot][scancode][0] == '\0')
+        return NULL;
+
+    return _glfw.wl.keynames[slot][scancode];
 }
 
 int _glfwPlatformGetKeyScancode(int key)
@@ -1391,7 +2309,7 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
                               const GLFWimage* image,
                               int xhot, int yhot)
 {
-    cursor->wl.buffer = createShmBuffer(image);
+    cursor->wl.buffer = createShmBuffer(image, cursor->format);
     if (!cursor->wl.buffer)
         return GLFW_FALSE;
 
@@ -1436,7 +2354,7 @@ void _glfwPlatformDestroyCursor(_GLFWcursor* cursor)
         return;
 
     if (cursor->wl.buffer)
-        wl_buffer_destroy(cursor->wl.buffer);
+        destroyShmBuffer(cursor->wl.buffer);
 }
 
 static void relativePointerHandleRelativeMotion(void* data,
@@ -1625,7 +2543,6 @@ static void dataSourceHandleSend(void* data,
 {
     const char* string = _glfw.wl.clipboardSendString;
     size_t len = _glfw.wl.clipboardSendSize;
-    int ret;
 
     if (_glfw.wl.dataSource != dataSource)
     {
@@ -1634,37 +2551,38 @@ static void dataSourceHandleSend(void* data,
         return;
     }
 
-    if (!string)
+    if (_glfw.clipboardProvider.callback)
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Copy requested from an invalid string");
-        return;
+        // The contents are only retrieved from the provider now that they are
+        // being pasted
+        string = _glfwProvideClipboardData(mimeType, &len);
+        if (!string)
+        {
+            close(fd);
+            return;
+        }
     }
-
-    if (strcmp(mimeType, "text/plain;charset=utf-8") != 0)
+    else
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Wrong MIME type asked from clipboard");
-        close(fd);
-        return;
-    }
+        if (!string)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Copy requested from an invalid string");
+            return;
+        }
 
-    while (len > 0)
-    {
-        ret = write(fd, string, len);
-        if (ret == -1 && errno == EINTR)
-            continue;
-        if (ret == -1)
+        if (strcmp(mimeType, "text/plain;charset=utf-8") != 0)
         {
-            // TODO: also report errno maybe.
             _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "Wayland: Error while writing the clipboard");
+                            "Wayland: Wrong MIME type asked from clipboard");
             close(fd);
             return;
         }
-        len -= ret;
     }
-    close(fd);
+
+    // The requestor may be slow to read, so the data is written as the event
+    // loop finds its pipe writable instead of blocking event processing
+    sendTransfer(fd, string, len);
 }
 
 static void dataSourceHandleCancelled(void* data,
@@ -1744,6 +2662,40 @@ static GLFWbool growClipboardString(void)
     return GLFW_TRUE;
 }
 
+GLFWbool _glfwPlatformSetClipboardProvider(void)
+{
+    if (_glfw.wl.dataSource)
+    {
+        wl_data_source_destroy(_glfw.wl.dataSource);
+        _glfw.wl.dataSource = NULL;
+    }
+
+    free(_glfw.wl.clipboardSendString);
+    _glfw.wl.clipboardSendString = NULL;
+
+    _glfw.wl.dataSource =
+        wl_data_device_manager_create_data_source(_glfw.wl.dataDeviceManager);
+    if (!_glfw.wl.dataSource)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Impossible to create clipboard source");
+        _glfwClearClipboardProvider();
+        return GLFW_TRUE;
+    }
+
+    wl_data_source_add_listener(_glfw.wl.dataSource,
+                                &dataSourceListener,
+                                NULL);
+
+    for (int i = 0;  i < _glfw.clipboardProvider.typeCount;  i++)
+        wl_data_source_offer(_glfw.wl.dataSource, _glfw.clipboardProvider.types[i]);
+
+    wl_data_device_set_selection(_glfw.wl.dataDevice,
+                                 _glfw.wl.dataSource,
+                                 _glfw.wl.serial);
+    return GLFW_TRUE;
+}
+
 const char* _glfwPlatformGetClipboardString(void)
 {
     int fds[2];
@@ -1785,6 +2737,10 @@ const char* _glfwPlatformGetClipboardString(void)
             }
         }
 
+        // The data may be coming from one of our own outgoing transfers, which
+        // only progress when written to
+        writeTransfers();
+
         // Then read from the fd to the clipboard, handling all known errors.
         ret = read(fds[0], _glfw.wl.clipboardString + len, 4096);
         if (ret == 0)
@@ -1811,6 +2767,42 @@ const char* _glfwPlatformGetClipboardString(void)
     return _glfw.wl.clipboardString;
 }
 
+GLFWbool _glfwPlatformRequestClipboardString(void)
+{
+    int fds[2];
+
+    // Without an offer there is nothing to read, which shared code reports
+    if (!_glfw.wl.dataOffer)
+        return GLFW_FALSE;
+
+    if (pipe2(fds, O_CLOEXEC) < 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create clipboard pipe: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    // Only our end is made non-blocking, as the source receives the other one
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    wl_data_offer_receive(_glfw.wl.dataOffer, "text/plain;charset=utf-8", fds[1]);
+    close(fds[1]);
+
+    _glfw.wl.clipboardRequest.active = GLFW_TRUE;
+    _glfw.wl.clipboardRequest.fd = fds[0];
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformCancelClipboardRequest(void)
+{
+    if (_glfw.wl.clipboardRequest.active)
+        close(_glfw.wl.clipboardRequest.fd);
+
+    free(_glfw.wl.clipboardRequest.data);
+    memset(&_glfw.wl.clipboardRequest, 0, sizeof(_glfw.wl.clipboardRequest));
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_wayland_surface)
@@ -206,205 +206,266 @@ static int translateKeySyms(const KeySym* keysyms, int width)
     return GLFW_KEY_UNKNOWN;
 }
 
+// XKB key name to GLFW key code mapping
+// Note: We use the US keyboard layout. Because function keys aren't mapped
+//       correctly when using traditional KeySym translations, they are
+//       mapped here instead.
+//
+static const struct
+{
+    int key;
+    char* name;
+} keymap[] =
+{
+    { GLFW_KEY_GRAVE_ACCENT, "TLDE" },
+    { GLFW_KEY_1, "AE01" },
+    { GLFW_KEY_2, "AE02" },
+    { GLFW_KEY_3, "AE03" },
+    { GLFW_KEY_4, "AE04" },
+    { GLFW_KEY_5, "AE05" },
+    { GLFW_KEY_6, "AE06" },
+    { GLFW_KEY_7, "AE07" },
+    { GLFW_KEY_8, "AE08" },
+    { GLFW_KEY_9, "AE09" },
+    { GLFW_KEY_0, "AE10" },
+    { GLFW_KEY_MINUS, "AE11" },
+    { GLFW_KEY_EQUAL, "AE12" },
+    { GLFW_KEY_Q, "AD01" },
+    { GLFW_KEY_W, "AD02" },
+    { GLFW_KEY_E, "AD03" },
+    { GLFW_KEY_R, "AD04" },
+    { GLFW_KEY_T, "AD05" },
+    { GLFW_KEY_Y, "AD06" },
+    { GLFW_KEY_U, "AD07" },
+    { GLFW_KEY_I, "AD08" },
+    { GLFW_KEY_O, "AD09" },
+    { GLFW_KEY_P, "AD10" },
+    { GLFW_KEY_LEFT_BRACKET, "AD11" },
+    { GLFW_KEY_RIGHT_BRACKET, "AD12" },
+    { GLFW_KEY_A, "AC01" },
+    { GLFW_KEY_S, "AC02" },
+    { GLFW_KEY_D, "AC03" },
+    { GLFW_KEY_F, "AC04" },
+    { GLFW_KEY_G, "AC05" },
+    { GLFW_KEY_H, "AC06" },
+    { GLFW_KEY_J, "AC07" },
+    { GLFW_KEY_K, "AC08" },
+    { GLFW_KEY_L, "AC09" },
+    { GLFW_KEY_SEMICOLON, "AC10" },
+    { GLFW_KEY_APOSTROPHE, "AC11" },
+    { GLFW_KEY_Z, "AB01" },
+    { GLFW_KEY_X, "AB02" },
+    { GLFW_KEY_C, "AB03" },
+    { GLFW_KEY_V, "AB04" },
+    { GLFW_KEY_B, "AB05" },
+    { GLFW_KEY_N, "AB06" },
+    { GLFW_KEY_M, "AB07" },
+    { GLFW_KEY_COMMA, "AB08" },
+    { GLFW_KEY_PERIOD, "AB09" },
+    { GLFW_KEY_SLASH, "AB10" },
+    { GLFW_KEY_BACKSLASH, "BKSL" },
+    { GLFW_KEY_WORLD_1, "LSGT" },
+    { GLFW_KEY_SPACE, "SPCE" },
+    { GLFW_KEY_ESCAPE, "ESC" },
+    { GLFW_KEY_ENTER, "RTRN" },
+    { GLFW_KEY_TAB, "TAB" },
+    { GLFW_KEY_BACKSPACE, "BKSP" },
+    { GLFW_KEY_INSERT, "INS" },
+    { GLFW_KEY_DELETE, "DELE" },
+    { GLFW_KEY_RIGHT, "RGHT" },
+    { GLFW_KEY_LEFT, "LEFT" },
+    { GLFW_KEY_DOWN, "DOWN" },
+    { GLFW_KEY_UP, "UP" },
+    { GLFW_KEY_PAGE_UP, "PGUP" },
+    { GLFW_KEY_PAGE_DOWN, "PGDN" },
+    { GLFW_KEY_HOME, "HOME" },
+    { GLFW_KEY_END, "END" },
+    { GLFW_KEY_CAPS_LOCK, "CAPS" },
+    { GLFW_KEY_SCROLL_LOCK, "SCLK" },
+    { GLFW_KEY_NUM_LOCK, "NMLK" },
+    { GLFW_KEY_PRINT_SCREEN, "PRSC" },
+    { GLFW_KEY_PAUSE, "PAUS" },
+    { GLFW_KEY_F1, "FK01" },
+    { GLFW_KEY_F2, "FK02" },
+    { GLFW_KEY_F3, "FK03" },
+    { GLFW_KEY_F4, "FK04" },
+    { GLFW_KEY_F5, "FK05" },
+    { GLFW_KEY_F6, "FK06" },
+    { GLFW_KEY_F7, "FK07" },
+    { GLFW_KEY_F8, "FK08" },
+    { GLFW_KEY_F9, "FK09" },
+    { GLFW_KEY_F10, "FK10" },
+    { GLFW_KEY_F11, "FK11" },
+    { GLFW_KEY_F12, "FK12" },
+    { GLFW_KEY_F13, "FK13" },
+    { GLFW_KEY_F14, "FK14" },
+    { GLFW_KEY_F15, "FK15" },
+    { GLFW_KEY_F16, "FK16" },
+    { GLFW_KEY_F17, "FK17" },
+    { GLFW_KEY_F18, "FK18" },
+    { GLFW_KEY_F19, "FK19" },
+    { GLFW_KEY_F20, "FK20" },
+    { GLFW_KEY_F21, "FK21" },
+    { GLFW_KEY_F22, "FK22" },
+    { GLFW_KEY_F23, "FK23" },
+    { GLFW_KEY_F24, "FK24" },
+    { GLFW_KEY_F25, "FK25" },
+    { GLFW_KEY_KP_0, "KP0" },
+    { GLFW_KEY_KP_1, "KP1" },
+    { GLFW_KEY_KP_2, "KP2" },
+    { GLFW_KEY_KP_3, "KP3" },
+    { GLFW_KEY_KP_4, "KP4" },
+    { GLFW_KEY_KP_5, "KP5" },
+    { GLFW_KEY_KP_6, "KP6" },
+    { GLFW_KEY_KP_7, "KP7" },
+    { GLFW_KEY_KP_8, "KP8" },
+    { GLFW_KEY_KP_9, "KP9" },
+    { GLFW_KEY_KP_DECIMAL, "KPDL" },
+    { GLFW_KEY_KP_DIVIDE, "KPDV" },
+    { GLFW_KEY_KP_MULTIPLY, "KPMU" },
+    { GLFW_KEY_KP_SUBTRACT, "KPSU" },
+    { GLFW_KEY_KP_ADD, "KPAD" },
+    { GLFW_KEY_KP_ENTER, "KPEN" },
+    { GLFW_KEY_KP_EQUAL, "KPEQ" },
+    { GLFW_KEY_LEFT_SHIFT, "LFSH" },
+    { GLFW_KEY_LEFT_CONTROL, "LCTL" },
+    { GLFW_KEY_LEFT_ALT, "LALT" },
+    { GLFW_KEY_LEFT_SUPER, "LWIN" },
+    { GLFW_KEY_RIGHT_SHIFT, "RTSH" },
+    { GLFW_KEY_RIGHT_CONTROL, "RCTL" },
+    { GLFW_KEY_RIGHT_ALT, "RALT" },
+    { GLFW_KEY_RIGHT_ALT, "LVL3" },
+    { GLFW_KEY_RIGHT_ALT, "MDSW" },
+    { GLFW_KEY_RIGHT_SUPER, "RWIN" },
+    { GLFW_KEY_MENU, "MENU" }
+};
+
+// Size of the key name hash table, a power of two at least twice the number
+// of entries in keymap[]
+//
+#define _GLFW_KEY_NAME_HASH_SIZE 256
+
+// Open addressing hash table of the packed key names in keymap[]
+// A zero name marks an empty slot, as no entry in keymap[] has an empty name
+//
+static struct
+{
+    uint32_t name;
+    short int key;
+} keyNameHash[_GLFW_KEY_NAME_HASH_SIZE];
+
+static GLFWbool keyNameHashBuilt = GLFW_FALSE;
+
+// Pack an XKB key name of up to XkbKeyNameLength characters into an integer
+// Names are compared up to the first NUL, exactly as strncmp would
+//
+static uint32_t packKeyName(const char* name)
+{
+    uint32_t packed = 0;
+
+    for (int i = 0;  i < XkbKeyNameLength && name[i];  i++)
+        packed |= (uint32_t) (unsigned char) name[i] << (i * 8);
+
+    return packed;
+}
+
+// Return the first hash table slot to probe for the specified packed name
+//
+static unsigned int hashKeyName(uint32_t name)
+{
+    return ((name * 2654435761u) >> 24) & (_GLFW_KEY_NAME_HASH_SIZE - 1);
+}
+
+// Fill the key name hash table from keymap[]
+//
+static void buildKeyNameHash(void)
+{
+    for (int i = 0;  i < sizeof(keymap) / sizeof(keymap[0]);  i++)
+    {
+        const uint32_t name = packKeyName(keymap[i].name);
+        unsigned int slot = hashKeyName(name);
+
+        // The first entry for a given name wins, as with a linear search
+        while (keyNameHash[slot].name && keyNameHash[slot].name != name)
+            slot = (slot + 1) & (_GLFW_KEY_NAME_HASH_SIZE - 1);
+
+        if (!keyNameHash[slot].name)
+        {
+            keyNameHash[slot].name = name;
+            keyNameHash[slot].key = keymap[i].key;
+        }
+    }
+
+    keyNameHashBuilt = GLFW_TRUE;
+}
+
+// Map a packed XKB key name to a GLFW key code
+//
+static int lookupKeyName(uint32_t name)
+{
+    if (!name)
+        return GLFW_KEY_UNKNOWN;
+
+    for (unsigned int slot = hashKeyName(name);
+         keyNameHash[slot].name;
+         slot = (slot + 1) & (_GLFW_KEY_NAME_HASH_SIZE - 1))
+    {
+        if (keyNameHash[slot].name == name)
+            return keyNameHash[slot].key;
+    }
+
+    return GLFW_KEY_UNKNOWN;
+}
+
 // Create key code translation tables
 //
-static void createKeyTables(void)
+static void createKeyTables(XkbDescPtr desc)
 {
     int scancode, scancodeMin, scancodeMax;
 
     memset(_glfw.x11.keycodes, -1, sizeof(_glfw.x11.keycodes));
     memset(_glfw.x11.scancodes, -1, sizeof(_glfw.x11.scancodes));
 
-    if (_glfw.x11.xkb.available)
+    if (desc)
     {
         // Use XKB to determine physical key locations independently of the
         // current keyboard layout
 
-        XkbDescPtr desc = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
         XkbGetNames(_glfw.x11.display, XkbKeyNamesMask | XkbKeyAliasesMask, desc);
 
         scancodeMin = desc->min_key_code;
         scancodeMax = desc->max_key_code;
 
-        const struct
-        {
-            int key;
-            char* name;
-        } keymap[] =
-        {
-            { GLFW_KEY_GRAVE_ACCENT, "TLDE" },
-            { GLFW_KEY_1, "AE01" },
-            { GLFW_KEY_2, "AE02" },
-            { GLFW_KEY_3, "AE03" },
-            { GLFW_KEY_4, "AE04" },
-            { GLFW_KEY_5, "AE05" },
-            { GLFW_KEY_6, "AE06" },
-            { GLFW_KEY_7, "AE07" },
-            { GLFW_KEY_8, "AE08" },
-            { GLFW_KEY_9, "AE09" },
-            { GLFW_KEY_0, "AE10" },
-            { GLFW_KEY_MINUS, "AE11" },
-            { GLFW_KEY_EQUAL, "AE12" },
-            { GLFW_KEY_Q, "AD01" },
-            { GLFW_KEY_W, "AD02" },
-            { GLFW_KEY_E, "AD03" },
-            { GLFW_KEY_R, "AD04" },
-            { GLFW_KEY_T, "AD05" },
-            { GLFW_KEY_Y, "AD06" },
-            { GLFW_KEY_U, "AD07" },
-            { GLFW_KEY_I, "AD08" },
-            { GLFW_KEY_O, "AD09" },
-            { GLFW_KEY_P, "AD10" },
-            { GLFW_KEY_LEFT_BRACKET, "AD11" },
-            { GLFW_KEY_RIGHT_BRACKET, "AD12" },
-            { GLFW_KEY_A, "AC01" },
-            { GLFW_KEY_S, "AC02" },
-            { GLFW_KEY_D, "AC03" },
-            { GLFW_KEY_F, "AC04" },
-            { GLFW_KEY_G, "AC05" },
-            { GLFW_KEY_H, "AC06" },
-            { GLFW_KEY_J, "AC07" },
-            { GLFW_KEY_K, "AC08" },
-            { GLFW_KEY_L, "AC09" },
-            { GLFW_KEY_SEMICOLON, "AC10" },
-            { GLFW_KEY_APOSTROPHE, "AC11" },
-            { GLFW_KEY_Z, "AB01" },
-            { GLFW_KEY_X, "AB02" },
-            { GLFW_KEY_C, "AB03" },
-            { GLFW_KEY_V, "AB04" },
-            { GLFW_KEY_B, "AB05" },
-            { GLFW_KEY_N, "AB06" },
-            { GLFW_KEY_M, "AB07" },
-            { GLFW_KEY_COMMA, "AB08" },
-            { GLFW_KEY_PERIOD, "AB09" },
-            { GLFW_KEY_SLASH, "AB10" },
-            { GLFW_KEY_BACKSLASH, "BKSL" },
-            { GLFW_KEY_WORLD_1, "LSGT" },
-            { GLFW_KEY_SPACE, "SPCE" },
-            { GLFW_KEY_ESCAPE, "ESC" },
-            { GLFW_KEY_ENTER, "RTRN" },
-            { GLFW_KEY_TAB, "TAB" },
-            { GLFW_KEY_BACKSPACE, "BKSP" },
-            { GLFW_KEY_INSERT, "INS" },
-            { GLFW_KEY_DELETE, "DELE" },
-            { GLFW_KEY_RIGHT, "RGHT" },
-            { GLFW_KEY_LEFT, "LEFT" },
-            { GLFW_KEY_DOWN, "DOWN" },
-            { GLFW_KEY_UP, "UP" },
-            { GLFW_KEY_PAGE_UP, "PGUP" },
-            { GLFW_KEY_PAGE_DOWN, "PGDN" },
-            { GLFW_KEY_HOME, "HOME" },
-            { GLFW_KEY_END, "END" },
-            { GLFW_KEY_CAPS_LOCK, "CAPS" },
-            { GLFW_KEY_SCROLL_LOCK, "SCLK" },
-            { GLFW_KEY_NUM_LOCK, "NMLK" },
-            { GLFW_KEY_PRINT_SCREEN, "PRSC" },
-            { GLFW_KEY_PAUSE, "PAUS" },
-            { GLFW_KEY_F1, "FK01" },
-            { GLFW_KEY_F2, "FK02" },
-            { GLFW_KEY_F3, "FK03" },
-            { GLFW_KEY_F4, "FK04" },
-            { GLFW_KEY_F5, "FK05" },
-            { GLFW_KEY_F6, "FK06" },
-            { GLFW_KEY_F7, "FK07" },
-            { GLFW_KEY_F8, "FK08" },
-            { GLFW_KEY_F9, "FK09" },
-            { GLFW_KEY_F10, "FK10" },
-            { GLFW_KEY_F11, "FK11" },
-            { GLFW_KEY_F12, "FK12" },
-            { GLFW_KEY_F13, "FK13" },
-            { GLFW_KEY_F14, "FK14" },
-            { GLFW_KEY_F15, "FK15" },
-            { GLFW_KEY_F16, "FK16" },
-            { GLFW_KEY_F17, "FK17" },
-            { GLFW_KEY_F18, "FK18" },
-            { GLFW_KEY_F19, "FK19" },
-            { GLFW_KEY_F20, "FK20" },
-            { GLFW_KEY_F21, "FK21" },
-            { GLFW_KEY_F22, "FK22" },
-            { GLFW_KEY_F23, "FK23" },
-            { GLFW_KEY_F24, "FK24" },
-            { GLFW_KEY_F25, "FK25" },
-            { GLFW_KEY_KP_0, "KP0" },
-            { GLFW_KEY_KP_1, "KP1" },
-            { GLFW_KEY_KP_2, "KP2" },
-            { GLFW_KEY_KP_3, "KP3" },
-            { GLFW_KEY_KP_4, "KP4" },
-            { GLFW_KEY_KP_5, "KP5" },
-            { GLFW_KEY_KP_6, "KP6" },
-            { GLFW_KEY_KP_7, "KP7" },
-            { GLFW_KEY_KP_8, "KP8" },
-            { GLFW_KEY_KP_9, "KP9" },
-            { GLFW_KEY_KP_DECIMAL, "KPDL" },
-            { GLFW_KEY_KP_DIVIDE, "KPDV" },
-            { GLFW_KEY_KP_MULTIPLY, "KPMU" },
-            { GLFW_KEY_KP_SUBTRACT, "KPSU" },
-            { GLFW_KEY_KP_ADD, "KPAD" },
-            { GLFW_KEY_KP_ENTER, "KPEN" },
-            { GLFW_KEY_KP_EQUAL, "KPEQ" },
-            { GLFW_KEY_LEFT_SHIFT, "LFSH" },
-            { GLFW_KEY_LEFT_CONTROL, "LCTL" },
-            { GLFW_KEY_LEFT_ALT, "LALT" },
-            { GLFW_KEY_LEFT_SUPER, "LWIN" },
-            { GLFW_KEY_RIGHT_SHIFT, "RTSH" },
-            { GLFW_KEY_RIGHT_CONTROL, "RCTL" },
-            { GLFW_KEY_RIGHT_ALT, "RALT" },
-            { GLFW_KEY_RIGHT_ALT, "LVL3" },
-            { GLFW_KEY_RIGHT_ALT, "MDSW" },
-            { GLFW_KEY_RIGHT_SUPER, "RWIN" },
-            { GLFW_KEY_MENU, "MENU" }
-        };
+        if (!keyNameHashBuilt)
+            buildKeyNameHash();
 
         // Find the X11 key code -> GLFW key code mapping
         for (scancode = scancodeMin;  scancode <= scancodeMax;  scancode++)
         {
-            int key = GLFW_KEY_UNKNOWN;
+            const uint32_t name = packKeyName(desc->names->keys[scancode].name);
+            _glfw.x11.keycodes[scancode] = lookupKeyName(name);
+        }
 
-            // Map the key name to a GLFW key code. Note: We use the US
-            // keyboard layout. Because function keys aren't mapped correctly
-            // when using traditional KeySym translations, they are mapped
-            // here instead.
-            for (int i = 0;  i < sizeof(keymap) / sizeof(keymap[0]);  i++)
-            {
-                if (strncmp(desc->names->keys[scancode].name,
-                            keymap[i].name,
-                            XkbKeyNameLength) == 0)
-                {
-                    key = keymap[i].key;
-                    break;
-                }
-            }
+        // Fall back to key aliases in case the key name did not match
+        // The first matching alias for a given key wins
+        for (int i = 0;  i < desc->names->num_key_aliases;  i++)
+        {
+            const int key =
+                lookupKeyName(packKeyName(desc->names->key_aliases[i].alias));
+            if (key == GLFW_KEY_UNKNOWN)
+                continue;
 
-            // Fall back to key aliases in case the key name did not match
-            for (int i = 0;  i < desc->names->num_key_aliases;  i++)
-            {
-                if (key != GLFW_KEY_UNKNOWN)
-                    break;
+            const uint32_t real = packKeyName(desc->names->key_aliases[i].real);
 
-                if (strncmp(desc->names->key_aliases[i].real,
-                            desc->names->keys[scancode].name,
-                            XkbKeyNameLength) != 0)
-                {
+            for (scancode = scancodeMin;  scancode <= scancodeMax;  scancode++)
+            {
+                if (_glfw.x11.keycodes[scancode] != GLFW_KEY_UNKNOWN)
                     continue;
-                }
-
-                for (int j = 0;  j < sizeof(keymap) / sizeof(keymap[0]);  j++)
-                {
-                    if (strncmp(desc->names->key_aliases[i].alias,
-                                keymap[j].name,
-                                XkbKeyNameLength) == 0)
-                    {
-                        key = keymap[j].key;
-                        break;
-                    }
-                }
-            }
 
-            _glfw.x11.keycodes[scancode] = key;
+                if (packKeyName(desc->names->keys[scancode].name) == real)
+                    _glfw.x11.keycodes[scancode] = key;
+            }
         }
-
-        XkbFreeNames(desc, XkbKeyNamesMask, True);
-        XkbFreeKeyboard(desc, 0, True);
     }
     else
         XDisplayKeycodes(_glfw.x11.display, &scancodeMin, &scancodeMax);
@@ -772,6 +833,11 @@ static GLFWbool initExtensions(void)
 
         XkbSelectEventDetails(_glfw.x11.display, XkbUseCoreKbd, XkbStateNotify,
                               XkbGroupStateMask, XkbGroupStateMask);
+        XkbSelectEventDetails(_glfw.x11.display, XkbUseCoreKbd,
+                              XkbNewKeyboardNotify,
+                              XkbNKN_KeycodesMask, XkbNKN_KeycodesMask);
+        XkbSelectEventDetails(_glfw.x11.display, XkbUseCoreKbd, XkbMapNotify,
+                              XkbKeySymsMask, XkbKeySymsMask);
     }
 
 #if defined(__CYGWIN__)
@@ -813,9 +879,8 @@ static GLFWbool initExtensions(void)
     }
 
     // Update the key code LUT
-    // FIXME: We should listen to XkbMapNotify events to track changes to
-    // the keyboard mapping.
-    createKeyTables();
+    // This is kept up to date by XkbNewKeyboardNotify and XkbMapNotify events
+    _glfwUpdateKeyTablesX11(GLFW_TRUE);
 
     // String format atoms
     _glfw.x11.NULL_ = XInternAtom(_glfw.x11.display, "NULL", False);
@@ -833,6 +898,12 @@ static GLFWbool initExtensions(void)
     _glfw.x11.INCR = XInternAtom(_glfw.x11.display, "INCR", False);
     _glfw.x11.CLIPBOARD = XInternAtom(_glfw.x11.display, "CLIPBOARD", False);
 
+    // Larger selection data is sent with the INCR mechanism (ICCCM 2.7.2)
+    // This is a quarter of the maximum request size, which is in 4-byte units
+    _glfw.x11.selectionChunkSize = XExtendedMaxRequestSize(_glfw.x11.display);
+    if (!_glfw.x11.selectionChunkSize)
+        _glfw.x11.selectionChunkSize = XMaxRequestSize(_glfw.x11.display);
+
     // Clipboard manager atoms
     _glfw.x11.CLIPBOARD_MANAGER =
         XInternAtom(_glfw.x11.display, "CLIPBOARD_MANAGER", False);
@@ -935,21 +1006,7 @@ static Cursor createHiddenCursor(void)
 {
     unsigned char pixels[16 * 16 * 4] = { 0 };
     GLFWimage image = { 16, 16, pixels };
-    return _glfwCreateCursorX11(&image, 0, 0);
-}
-
-// Create a helper window for IPC
-//
-static Window createHelperWindow(void)
-{
-    XSetWindowAttributes wa;
-    wa.event_mask = PropertyChangeMask;
-
-    return XCreateWindow(_glfw.x11.display, _glfw.x11.root,
-                         0, 0, 1, 1, 0, 0,
-                         InputOnly,
-                         DefaultVisual(_glfw.x11.display, _glfw.x11.screen),
-                         CWEventMask, &wa);
+    return _glfwCreateCursorX11(&image, GLFW_IMAGE_RGBA, 0, 0);
 }
 
 // X error handler
@@ -968,6 +1025,20 @@ static int errorHandler(Display *display, XErrorEvent* event)
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Creates a helper window for IPC
+//
+Window _glfwCreateHelperWindowX11(void)
+{
+    XSetWindowAttributes wa;
+    wa.event_mask = PropertyChangeMask;
+
+    return XCreateWindow(_glfw.x11.display, _glfw.x11.root,
+                         0, 0, 1, 1, 0, 0,
+                         InputOnly,
+                         DefaultVisual(_glfw.x11.display, _glfw.x11.screen),
+                         CWEventMask, &wa);
+}
+
 // Sets the X error handler callback
 //
 void _glfwGrabErrorHandlerX11(void)
@@ -996,11 +1067,115 @@ void _glfwInputErrorX11(int error, const char* message)
     _glfwInputError(error, "%s: %s", message, buffer);
 }
 
+// Updates the key code translation tables for the current keyboard mapping
+// If reuse is true, tables cached for the same XKB keymap names are used
+//
+void _glfwUpdateKeyTablesX11(GLFWbool reuse)
+{
+    XkbDescPtr desc = NULL;
+    int slot = -1;
+
+    // Key names are looked up anew for the changed keyboard mapping
+    memset(_glfw.x11.keynamesValid, 0, sizeof(_glfw.x11.keynamesValid));
+
+    if (_glfw.x11.xkb.available)
+    {
+        desc = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
+        if (desc)
+        {
+            XkbGetNames(_glfw.x11.display,
+                        XkbKeycodesNameMask | XkbSymbolsNameMask,
+                        desc);
+        }
+    }
+
+    // A keymap without keycodes and symbols names cannot be identified and
+    // so is never cached
+    if (desc && desc->names &&
+        desc->names->keycodes != None && desc->names->symbols != None)
+    {
+        for (int i = 0;  i < _GLFW_KEY_TABLE_CACHE_SIZE;  i++)
+        {
+            if (_glfw.x11.keyTableCache[i].keycodesName == desc->names->keycodes &&
+                _glfw.x11.keyTableCache[i].symbolsName == desc->names->symbols)
+            {
+                slot = i;
+                break;
+            }
+        }
+
+        if (slot != -1 && reuse)
+        {
+            memcpy(_glfw.x11.keycodes,
+                   _glfw.x11.keyTableCache[slot].keycodes,
+                   sizeof(_glfw.x11.keycodes));
+            memcpy(_glfw.x11.scancodes,
+                   _glfw.x11.keyTableCache[slot].scancodes,
+                   sizeof(_glfw.x11.scancodes));
+
+            XkbFreeKeyboard(desc, 0, True);
+            return;
+        }
+
+        if (slot == -1)
+        {
+            slot = _glfw.x11.keyTableCacheNext;
+            _glfw.x11.keyTableCacheNext =
+                (_glfw.x11.keyTableCacheNext + 1) % _GLFW_KEY_TABLE_CACHE_SIZE;
+
+            _glfw.x11.keyTableCache[slot].keycodesName = desc->names->keycodes;
+            _glfw.x11.keyTableCache[slot].symbolsName = desc->names->symbols;
+        }
+    }
+
+    createKeyTables(desc);
+
+    if (slot != -1)
+    {
+        memcpy(_glfw.x11.keyTableCache[slot].keycodes,
+               _glfw.x11.keycodes,
+               sizeof(_glfw.x11.keycodes));
+        memcpy(_glfw.x11.keyTableCache[slot].scancodes,
+               _glfw.x11.scancodes,
+               sizeof(_glfw.x11.scancodes));
+    }
+
+    if (desc)
+        XkbFreeKeyboard(desc, 0, True);
+}
+
+// Opens the XIM input method on first use, unless disabled by init hint
+//
+GLFWbool _glfwOpenInputMethodX11(void)
+{
+    if (_glfw.x11.imRequested)
+        return _glfw.x11.im != NULL;
+
+    _glfw.x11.imRequested = GLFW_TRUE;
+
+    if (!_glfw.hints.init.x11.xim || !XSupportsLocale())
+        return GLFW_FALSE;
+
+    XSetLocaleModifiers("");
+
+    _glfw.x11.im = XOpenIM(_glfw.x11.display, 0, NULL, NULL);
+    if (_glfw.x11.im)
+    {
+        if (!hasUsableInputMethodStyle())
+        {
+            XCloseIM(_glfw.x11.im);
+            _glfw.x11.im = NULL;
+        }
+    }
+
+    return _glfw.x11.im != NULL;
+}
+
 // Creates a native cursor object from the specified image and hotspot
 //
-Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
+Cursor _glfwCreateCursorX11(const GLFWimage* image, int format,
+                             int xhot, int yhot)
 {
-    int i;
     Cursor cursor;
 
     if (!_glfw.x11.xcursor.handle)
@@ -1013,18 +1188,8 @@ Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
     native->xhot = xhot;
     native->yhot = yhot;
 
-    unsigned char* source = (unsigned char*) image->pixels;
-    XcursorPixel* target = native->pixels;
-
-    for (i = 0;  i < image->width * image->height;  i++, target++, source += 4)
-    {
-        unsigned int alpha = source[3];
-
-        *target = (alpha << 24) |
-                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
-                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
-                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
-    }
+    _glfwConvertImage(image, format, _GLFW_PIXELS_ARGB, GLFW_TRUE,
+                      native->pixels);
 
     cursor = XcursorImageLoadCursor(_glfw.x11.display, native);
     XcursorImageDestroy(native);
@@ -1046,6 +1211,10 @@ int _glfwPlatformInit(void)
     if (strcmp(setlocale(LC_CTYPE, NULL), "C") == 0)
         setlocale(LC_CTYPE, "");
 
+    // The timer is initialized first, as joystick devices timestamp their
+    // events with the clock it selects
+    _glfwInitTimerPOSIX();
+
     XInitThreads();
     XrmInitialize();
 
@@ -1076,31 +1245,9 @@ int _glfwPlatformInit(void)
     if (!initExtensions())
         return GLFW_FALSE;
 
-    _glfw.x11.helperWindowHandle = createHelperWindow();
+    _glfw.x11.helperWindowHandle = _glfwCreateHelperWindowX11();
     _glfw.x11.hiddenCursorHandle = createHiddenCursor();
 
-    if (XSupportsLocale())
-    {
-        XSetLocaleModifiers("");
-
-        _glfw.x11.im = XOpenIM(_glfw.x11.display, 0, NULL, NULL);
-        if (_glfw.x11.im)
-        {
-            if (!hasUsableInputMethodStyle())
-            {
-                XCloseIM(_glfw.x11.im);
-                _glfw.x11.im = NULL;
-            }
-        }
-    }
-
-#if defined(__linux__)
-    if (!_glfwInitJoysticksLinux())
-        return GLFW_FALSE;
-#endif
-
-    _glfwInitTimerPOSIX();
-
     _glfwPollMonitorsX11();
     return GLFW_TRUE;
 }
@@ -1119,6 +1266,14 @@ void _glfwPlatformTerminate(void)
         _glfw.x11.helperWindowHandle = None;
     }
 
+    if (_glfw.x11.clipboardRequestHandle)
+    {
+        XDestroyWindow(_glfw.x11.display, _glfw.x11.clipboardRequestHandle);
+        _glfw.x11.clipboardRequestHandle = None;
+    }
+
+    free(_glfw.x11.clipboardRequest.data);
+
     if (_glfw.x11.hiddenCursorHandle)
     {
         XFreeCursor(_glfw.x11.display, _glfw.x11.hiddenCursorHandle);
@@ -1127,6 +1282,14 @@ void _glfwPlatformTerminate(void)
 
     free(_glfw.x11.primarySelectionString);
     free(_glfw.x11.clipboardString);
+    free(_glfw.x11.clipboardTargets);
+
+    _glfwTerminateKeySym2Unicode();
+
+    for (int i = 0;  i < _glfw.x11.transferCount;  i++)
+        free(_glfw.x11.transfers[i].data);
+
+    free(_glfw.x11.transfers);
 
     if (_glfw.x11.im)
     {
@@ -1186,10 +1349,6 @@ void _glfwPlatformTerminate(void)
     //       cleanup callbacks that get called by that function
     _glfwTerminateEGL();
     _glfwTerminateGLX();
-
-#if defined(__linux__)
-    _glfwTerminateJoysticksLinux();
-#endif
 }
 
 const char* _glfwPlatformGetVersionString(void)
@@ -173,6 +173,9 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR)(Vk
 #define _GLFW_PLATFORM_MONITOR_STATE        _GLFWmonitorX11 x11
 #define _GLFW_PLATFORM_CURSOR_STATE         _GLFWcursorX11  x11
 
+// The number of keyboard mappings whose key code LUTs are kept
+#define _GLFW_KEY_TABLE_CACHE_SIZE 4
+
 
 // X11-specific per-window data
 //
@@ -182,6 +185,8 @@ typedef struct _GLFWwindowX11
     Window          handle;
     Window          parent;
     XIC             ic;
+    // Whether creation of the input context has been attempted
+    GLFWbool        icRequested;
 
     GLFWbool        overrideRedirect;
     GLFWbool        iconified;
@@ -204,6 +209,19 @@ typedef struct _GLFWwindowX11
 
 } _GLFWwindowX11;
 
+// X11-specific outgoing INCR selection transfer
+//
+typedef struct _GLFWtransferX11
+{
+    Window          requestor;
+    Atom            property;
+    Atom            target;
+    char*           data;
+    size_t          size;
+    size_t          offset;
+
+} _GLFWtransferX11;
+
 // X11-specific global data
 //
 typedef struct _GLFWlibraryX11
@@ -216,24 +234,54 @@ typedef struct _GLFWlibraryX11
     float           contentScaleX, contentScaleY;
     // Helper window for IPC
     Window          helperWindowHandle;
+    // Helper window for asynchronous clipboard requests, created on first use
+    Window          clipboardRequestHandle;
     // Invisible cursor for hidden cursor mode
     Cursor          hiddenCursorHandle;
     // Context for mapping window XIDs to _GLFWwindow pointers
     XContext        context;
-    // XIM input method
+    // XIM input method, opened when first needed for text input
     XIM             im;
+    // Whether opening the input method has been attempted
+    GLFWbool        imRequested;
     // Most recent error code received by X error handler
     int             errorCode;
     // Primary selection string (while the primary selection is owned)
     char*           primarySelectionString;
     // Clipboard string (while the selection is owned)
     char*           clipboardString;
-    // Key name string
-    char            keynames[GLFW_KEY_LAST + 1][5];
+    // Selection targets of the clipboard provider types (while it is set)
+    Atom*           clipboardTargets;
+    // Largest selection data written to a property in a single request
+    size_t          selectionChunkSize;
+    // Outgoing INCR selection transfers in progress
+    _GLFWtransferX11* transfers;
+    int             transferCount;
+    // Asynchronous clipboard request in progress
+    struct {
+        GLFWbool    active;
+        GLFWbool    incremental;
+        int         target;
+        char*       data;
+        size_t      size;
+    } clipboardRequest;
+    // Key name strings per keyboard group and X11 keycode, filled on first use
+    char            keynames[XkbNumKbdGroups][256][5];
+    // Whether the key names of each keyboard group are up to date
+    GLFWbool        keynamesValid[XkbNumKbdGroups];
     // X11 keycode to GLFW key LUT
     short int       keycodes[256];
     // GLFW key to X11 keycode LUT
     short int       scancodes[GLFW_KEY_LAST + 1];
+    // Key code LUTs of recently used XKB keymaps, keyed by their names
+    struct {
+        Atom        keycodesName;
+        Atom        symbolsName;
+        short int   keycodes[256];
+        short int   scancodes[GLFW_KEY_LAST + 1];
+    } keyTableCache[_GLFW_KEY_TABLE_CACHE_SIZE];
+    // Key code LUT cache slot to replace next
+    int             keyTableCacheNext;
     // Where to place the cursor when re-enabled
     double          restoreCursorPosX, restoreCursorPosY;
     // The window whose disabled cursor mode is active
@@ -434,7 +482,8 @@ void _glfwPollMonitorsX11(void);
 void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired);
 void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor);
 
-Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot);
+Cursor _glfwCreateCursorX11(const GLFWimage* image, int format,
+                             int xhot, int yhot);
 
 unsigned long _glfwGetWindowPropertyX11(Window window,
                                         Atom property,
@@ -445,6 +494,9 @@ GLFWbool _glfwIsVisualTransparentX11(Visual* visual);
 void _glfwGrabErrorHandlerX11(void);
 void _glfwReleaseErrorHandlerX11(void);
 void _glfwInputErrorX11(int error, const char* message);
+void _glfwUpdateKeyTablesX11(GLFWbool reuse);
+Window _glfwCreateHelperWindowX11(void);
+GLFWbool _glfwOpenInputMethodX11(void);
 
 void _glfwPushSelectionToManagerX11(void);
 
@@ -57,28 +57,28 @@
 #define _GLFW_XDND_VERSION 5
 
 
-// Wait for data to arrive using select
+// Wait for data to arrive on the specified file descriptor or any of the
+// additional ones using select
 // This avoids blocking other threads via the per-display Xlib lock that also
 // covers GLX functions
 //
-static GLFWbool waitForEvent(double* timeout)
+static GLFWbool waitForData(int fd, const int* fds, int count, fd_set* ready,
+                            double* timeout)
 {
-    fd_set fds;
-    const int fd = ConnectionNumber(_glfw.x11.display);
-    int count = fd + 1;
+    int i, nfds = fd + 1;
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (fds[i] >= nfds)
+            nfds = fds[i] + 1;
+    }
 
-#if defined(__linux__)
-    if (_glfw.linjs.inotify > fd)
-        count = _glfw.linjs.inotify + 1;
-#endif
     for (;;)
     {
-        FD_ZERO(&fds);
-        FD_SET(fd, &fds);
-#if defined(__linux__)
-        if (_glfw.linjs.inotify > 0)
-            FD_SET(_glfw.linjs.inotify, &fds);
-#endif
+        FD_ZERO(ready);
+        FD_SET(fd, ready);
+        for (i = 0;  i < count;  i++)
+            FD_SET(fds[i], ready);
 
         if (timeout)
         {
@@ -87,7 +87,7 @@ static GLFWbool waitForEvent(double* timeout)
             struct timeval tv = { seconds, microseconds };
             const uint64_t base = _glfwPlatformGetTimerValue();
 
-            const int result = select(count, &fds, NULL, NULL, &tv);
+            const int result = select(nfds, ready, NULL, NULL, &tv);
             const int error = errno;
 
             *timeout -= (_glfwPlatformGetTimerValue() - base) /
@@ -98,11 +98,51 @@ static GLFWbool waitForEvent(double* timeout)
             if ((result == -1 && error == EINTR) || *timeout <= 0.0)
                 return GLFW_FALSE;
         }
-        else if (select(count, &fds, NULL, NULL, NULL) != -1 || errno != EINTR)
+        else if (select(nfds, ready, NULL, NULL, NULL) != -1 || errno != EINTR)
             return GLFW_TRUE;
     }
 }
 
+// Wait for data to arrive on the X connection
+//
+static GLFWbool waitForEvent(double* timeout)
+{
+    fd_set ready;
+    return waitForData(ConnectionNumber(_glfw.x11.display), NULL, 0,
+                       &ready, timeout);
+}
+
+// Wait for X events or joystick events to arrive
+//
+static GLFWbool waitForAnyEvent(double* timeout)
+{
+    while (!XPending(_glfw.x11.display))
+    {
+        fd_set ready;
+        int i, count = 0;
+        const int* fds = NULL;
+
+#if defined(__linux__)
+        if (_glfw.joysticksInitialized)
+            fds = _glfwGetJoystickFdsLinux(&count);
+#endif
+
+        if (!waitForData(ConnectionNumber(_glfw.x11.display), fds, count,
+                         &ready, timeout))
+        {
+            return GLFW_FALSE;
+        }
+
+        for (i = 0;  i < count;  i++)
+        {
+            if (FD_ISSET(fds[i], &ready))
+                return GLFW_TRUE;
+        }
+    }
+
+    return GLFW_TRUE;
+}
+
 // Waits until a VisibilityNotify event arrives for the specified window or the
 // timeout period elapses (ICCCM section 4.2.2)
 //
@@ -159,6 +199,22 @@ static Bool isSelectionEvent(Display* display, XEvent* event, XPointer pointer)
            event->type == SelectionClear;
 }
 
+// Returns whether the event is for the requestor of an INCR selection transfer
+//
+static Bool isTransferEvent(Display* display, XEvent* event, XPointer pointer)
+{
+    if (event->type != PropertyNotify && event->type != DestroyNotify)
+        return False;
+
+    for (int i = 0;  i < _glfw.x11.transferCount;  i++)
+    {
+        if (event->xany.window == _glfw.x11.transfers[i].requestor)
+            return True;
+    }
+
+    return False;
+}
+
 // Returns whether it is a _NET_FRAME_EXTENTS event for the specified window
 //
 static Bool isFrameExtentsEvent(Display* display, XEvent* event, XPointer pointer)
@@ -207,13 +263,82 @@ static int translateState(int state)
 //
 static int translateKey(int scancode)
 {
-    // Use the pre-filled LUT (see createKeyTables() in x11_init.c)
+    // Use the pre-filled LUT (see _glfwUpdateKeyTablesX11() in x11_init.c)
     if (scancode < 0 || scancode > 255)
         return GLFW_KEY_UNKNOWN;
 
     return _glfw.x11.keycodes[scancode];
 }
 
+// Creates the input context of the window once it has a text input callback
+// The input method and context are not needed by windows without one
+// The input context is given focus by the caller
+//
+static void updateInputContext(_GLFWwindow* window)
+{
+    if (window->x11.icRequested)
+        return;
+
+    if (!window->callbacks.character &&
+        !window->callbacks.charmods &&
+        !window->callbacks.text)
+    {
+        return;
+    }
+
+    window->x11.icRequested = GLFW_TRUE;
+
+    if (!_glfwOpenInputMethodX11())
+        return;
+
+    window->x11.ic = XCreateIC(_glfw.x11.im,
+                               XNInputStyle,
+                               XIMPreeditNothing | XIMStatusNothing,
+                               XNClientWindow,
+                               window->x11.handle,
+                               XNFocusWindow,
+                               window->x11.handle,
+                               NULL);
+    if (!window->x11.ic)
+        return;
+
+    unsigned long filter = 0;
+    if (XGetICValues(window->x11.ic, XNFilterEvents, &filter, NULL) == NULL)
+    {
+        XWindowAttributes attribs;
+        XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
+        XSelectInput(_glfw.x11.display, window->x11.handle,
+                     attribs.your_event_mask | filter);
+    }
+}
+
+// Fills the key name cache of the specified keyboard group
+//
+static void updateKeyNames(unsigned int group)
+{
+    memset(_glfw.x11.keynames[group], 0, sizeof(_glfw.x11.keynames[group]));
+
+    for (int scancode = 0;  scancode < 256;  scancode++)
+    {
+        if (_glfw.x11.keycodes[scancode] == GLFW_KEY_UNKNOWN)
+            continue;
+
+        const KeySym keysym = XkbKeycodeToKeysym(_glfw.x11.display,
+                                                 scancode, group, 0);
+        if (keysym == NoSymbol)
+            continue;
+
+        const long ch = _glfwKeySym2Unicode(keysym);
+        if (ch == -1)
+            continue;
+
+        char* name = _glfw.x11.keynames[group][scancode];
+        name[_glfwEncodeUTF8(name, (unsigned int) ch)] = '\0';
+    }
+
+    _glfw.x11.keynamesValid[group] = GLFW_TRUE;
+}
+
 // Sends an EWMH or ICCCM event to the window manager
 //
 static void sendEventToWM(_GLFWwindow* window, Atom type,
@@ -378,88 +503,6 @@ static void updateWindowMode(_GLFWwindow* window)
     }
 }
 
-// Splits and translates a text/uri-list into separate file paths
-// NOTE: This function destroys the provided string
-//
-static char** parseUriList(char* text, int* count)
-{
-    const char* prefix = "file://";
-    char** paths = NULL;
-    char* line;
-
-    *count = 0;
-
-    while ((line = strtok(text, "\r\n")))
-    {
-        text = NULL;
-
-        if (line[0] == '#')
-            continue;
-
-        if (strncmp(line, prefix, strlen(prefix)) == 0)
-        {
-            line += strlen(prefix);
-            // TODO: Validate hostname
-            while (*line != '/')
-                line++;
-        }
-
-        (*count)++;
-
-        char* path = calloc(strlen(line) + 1, 1);
-        paths = realloc(paths, *count * sizeof(char*));
-        paths[*count - 1] = path;
-
-        while (*line)
-        {
-            if (line[0] == '%' && line[1] && line[2])
-            {
-                const char digits[3] = { line[1], line[2], '\0' };
-                *path = strtol(digits, NULL, 16);
-                line += 2;
-            }
-            else
-                *path = *line;
-
-            path++;
-            line++;
-        }
-    }
-
-    return paths;
-}
-
-// Encode a Unicode code point to a UTF-8 stream
-// Based on cutef8 by Jeff Bezanson (Public Domain)
-//
-static size_t encodeUTF8(char* s, unsigned int ch)
-{
-    size_t count = 0;
-
-    if (ch < 0x80)
-        s[count++] = (char) ch;
-    else if (ch < 0x800)
-    {
-        s[count++] = (ch >> 6) | 0xc0;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-    else if (ch < 0x10000)
-    {
-        s[count++] = (ch >> 12) | 0xe0;
-        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-    else if (ch < 0x110000)
-    {
-        s[count++] = (ch >> 18) | 0xf0;
-        s[count++] = ((ch >> 12) & 0x3f) | 0x80;
-        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-
-    return count;
-}
-
 // Decode a Unicode code point from a UTF-8 stream
 // Based on cutef8 by Jeff Bezanson (Public Domain)
 //
@@ -499,7 +542,7 @@ static char* convertLatin1toUTF8(const char* source)
     char* tp = target;
 
     for (sp = source;  *sp;  sp++)
-        tp += encodeUTF8(tp, *sp);
+        tp += _glfwEncodeUTF8(tp, *sp);
 
     return target;
 }
@@ -770,45 +813,232 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
 
     _glfwPlatformSetWindowTitle(window, wndconfig->title);
 
-    if (_glfw.x11.im)
+    _glfwPlatformGetWindowPos(window, &window->x11.xpos, &window->x11.ypos);
+    _glfwPlatformGetWindowSize(window, &window->x11.width, &window->x11.height);
+
+    return GLFW_TRUE;
+}
+
+// Set the specified property to the specified selection data, starting an INCR
+// transfer if it is too large to be written in a single request
+// Returns whether the data was written or a transfer started
+//
+static GLFWbool writeSelectionData(Window requestor, Atom property, Atom target,
+                                   const char* data, size_t size)
+{
+    if (size <= _glfw.x11.selectionChunkSize)
     {
-        window->x11.ic = XCreateIC(_glfw.x11.im,
-                                   XNInputStyle,
-                                   XIMPreeditNothing | XIMStatusNothing,
-                                   XNClientWindow,
-                                   window->x11.handle,
-                                   XNFocusWindow,
-                                   window->x11.handle,
-                                   NULL);
+        XChangeProperty(_glfw.x11.display,
+                        requestor,
+                        property,
+                        target,
+                        8,
+                        PropModeReplace,
+                        (unsigned char*) data,
+                        size);
+        return GLFW_TRUE;
     }
 
-    if (window->x11.ic)
+    // Our own requestors read the selection directly when we own it and
+    // cannot take part in a transfer, as their events are handled elsewhere
+    if (requestor == _glfw.x11.helperWindowHandle ||
+        requestor == _glfw.x11.clipboardRequestHandle)
     {
-        unsigned long filter = 0;
-        if (XGetICValues(window->x11.ic, XNFilterEvents, &filter, NULL) == NULL)
-            XSelectInput(_glfw.x11.display, window->x11.handle, wa.event_mask | filter);
+        return GLFW_FALSE;
     }
 
-    _glfwPlatformGetWindowPos(window, &window->x11.xpos, &window->x11.ypos);
-    _glfwPlatformGetWindowSize(window, &window->x11.width, &window->x11.height);
+    _GLFWtransferX11* transfers =
+        realloc(_glfw.x11.transfers,
+                sizeof(_GLFWtransferX11) * (_glfw.x11.transferCount + 1));
+    char* copy = malloc(size);
+    if (!transfers || !copy)
+    {
+        if (transfers)
+            _glfw.x11.transfers = transfers;
+
+        free(copy);
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
 
+    // The data is copied as the selection may change during the transfer
+    memcpy(copy, data, size);
+
+    _glfw.x11.transfers = transfers;
+    _GLFWtransferX11* transfer = transfers + _glfw.x11.transferCount++;
+    transfer->requestor = requestor;
+    transfer->property = property;
+    transfer->target = target;
+    transfer->data = copy;
+    transfer->size = size;
+    transfer->offset = 0;
+
+    // The requestor deletes the property to ask for the next chunk
+    // The events must be selected before the selection notification is sent
+    XSelectInput(_glfw.x11.display, requestor,
+                 PropertyChangeMask | StructureNotifyMask);
+
+    // The INCR property holds a lower bound on the size of the data
+    const long bound = size;
+    XChangeProperty(_glfw.x11.display,
+                    requestor,
+                    property,
+                    _glfw.x11.INCR,
+                    32,
+                    PropModeReplace,
+                    (unsigned char*) &bound,
+                    1);
     return GLFW_TRUE;
 }
 
-// Set the specified property to the selection converted to the requested target
+// Removes the specified INCR selection transfer
 //
-static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
+static void removeTransfer(int index, GLFWbool destroyed)
+{
+    const Window requestor = _glfw.x11.transfers[index].requestor;
+
+    free(_glfw.x11.transfers[index].data);
+    _glfw.x11.transfers[index] =
+        _glfw.x11.transfers[--_glfw.x11.transferCount];
+
+    if (destroyed)
+        return;
+
+    for (int i = 0;  i < _glfw.x11.transferCount;  i++)
+    {
+        if (_glfw.x11.transfers[i].requestor == requestor)
+            return;
+    }
+
+    // The requestor may have been destroyed since the last chunk was sent
+    _glfwGrabErrorHandlerX11();
+    XSelectInput(_glfw.x11.display, requestor, NoEventMask);
+    _glfwReleaseErrorHandlerX11();
+}
+
+// Sends the next chunk of an INCR selection transfer once the requestor has
+// deleted the previous one, ending with a zero-length chunk
+//
+static void handleTransferEvent(const XEvent* event)
+{
+    if (event->type == DestroyNotify)
+    {
+        // The requestor went away and any transfers to it are abandoned
+        for (int i = _glfw.x11.transferCount - 1;  i >= 0;  i--)
+        {
+            if (_glfw.x11.transfers[i].requestor == event->xdestroywindow.window)
+                removeTransfer(i, GLFW_TRUE);
+        }
+
+        return;
+    }
+
+    if (event->xproperty.state != PropertyDelete)
+        return;
+
+    for (int i = 0;  i < _glfw.x11.transferCount;  i++)
+    {
+        _GLFWtransferX11* transfer = _glfw.x11.transfers + i;
+
+        if (transfer->requestor != event->xproperty.window ||
+            transfer->property != event->xproperty.atom)
+        {
+            continue;
+        }
+
+        size_t count = transfer->size - transfer->offset;
+        if (count > _glfw.x11.selectionChunkSize)
+            count = _glfw.x11.selectionChunkSize;
+
+        // The requestor may have been destroyed without us having been told
+        _glfwGrabErrorHandlerX11();
+        XChangeProperty(_glfw.x11.display,
+                        transfer->requestor,
+                        transfer->property,
+                        transfer->target,
+                        8,
+                        PropModeReplace,
+                        (unsigned char*) transfer->data + transfer->offset,
+                        count);
+        _glfwReleaseErrorHandlerX11();
+
+        transfer->offset += count;
+
+        if (count == 0 || _glfw.x11.errorCode != Success)
+            removeTransfer(i, _glfw.x11.errorCode != Success);
+
+        return;
+    }
+}
+
+// Returns the clipboard provider type offered as the specified target, if any
+//
+static const char* getProviderType(Atom target)
+{
+    for (int i = 0;  i < _glfw.clipboardProvider.typeCount;  i++)
+    {
+        const char* type = _glfw.clipboardProvider.types[i];
+
+        if (target == _glfw.x11.clipboardTargets[i])
+            return type;
+
+        // UTF-8 text is also offered as the targets understood by X11 clients
+        if (target == _glfw.x11.UTF8_STRING || target == XA_STRING)
+        {
+            if (strcmp(type, "text/plain;charset=utf-8") == 0)
+                return type;
+        }
+    }
+
+    return NULL;
+}
+
+// Writes the selection converted to the specified data target to the specified
+// property of the requestor, returning whether the target is supported
+//
+static GLFWbool writeDataTarget(const XSelectionRequestEvent* request,
+                                Atom property, Atom target)
 {
-    int i;
-    char* selectionString = NULL;
-    const Atom formats[] = { _glfw.x11.UTF8_STRING, XA_STRING };
-    const int formatCount = sizeof(formats) / sizeof(formats[0]);
+    if (request->selection == _glfw.x11.CLIPBOARD &&
+        _glfw.clipboardProvider.callback)
+    {
+        const char* type = getProviderType(target);
+        if (!type)
+            return GLFW_FALSE;
+
+        size_t size;
+        const char* data = _glfwProvideClipboardData(type, &size);
+        if (!data)
+            return GLFW_FALSE;
+
+        return writeSelectionData(request->requestor, property, target,
+                                  data, size);
+    }
+
+    const char* selectionString;
 
     if (request->selection == _glfw.x11.PRIMARY)
         selectionString = _glfw.x11.primarySelectionString;
     else
         selectionString = _glfw.x11.clipboardString;
 
+    if (!selectionString)
+        return GLFW_FALSE;
+
+    if (target != _glfw.x11.UTF8_STRING && target != XA_STRING)
+        return GLFW_FALSE;
+
+    return writeSelectionData(request->requestor,
+                              property,
+                              target,
+                              selectionString,
+                              strlen(selectionString));
+}
+
+// Set the specified property to the selection converted to the requested target
+//
+static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
+{
     if (request->property == None)
     {
         // The requester is a legacy client (ICCCM section 2.2)
@@ -820,10 +1050,41 @@ static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
     {
         // The list of supported targets was requested
 
-        const Atom targets[] = { _glfw.x11.TARGETS,
-                                 _glfw.x11.MULTIPLE,
-                                 _glfw.x11.UTF8_STRING,
-                                 XA_STRING };
+        Atom targets[4];
+        Atom* providerTargets = NULL;
+        int count = 0;
+
+        if (request->selection == _glfw.x11.CLIPBOARD &&
+            _glfw.clipboardProvider.callback)
+        {
+            const int typeCount = _glfw.clipboardProvider.typeCount;
+
+            providerTargets = calloc(typeCount + 4, sizeof(Atom));
+            if (!providerTargets)
+            {
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                return None;
+            }
+
+            providerTargets[count++] = _glfw.x11.TARGETS;
+            providerTargets[count++] = _glfw.x11.MULTIPLE;
+
+            for (int i = 0;  i < typeCount;  i++)
+                providerTargets[count++] = _glfw.x11.clipboardTargets[i];
+
+            if (getProviderType(_glfw.x11.UTF8_STRING))
+            {
+                providerTargets[count++] = _glfw.x11.UTF8_STRING;
+                providerTargets[count++] = XA_STRING;
+            }
+        }
+        else
+        {
+            targets[count++] = _glfw.x11.TARGETS;
+            targets[count++] = _glfw.x11.MULTIPLE;
+            targets[count++] = _glfw.x11.UTF8_STRING;
+            targets[count++] = XA_STRING;
+        }
 
         XChangeProperty(_glfw.x11.display,
                         request->requestor,
@@ -831,9 +1092,10 @@ static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
                         XA_ATOM,
                         32,
                         PropModeReplace,
-                        (unsigned char*) targets,
-                        sizeof(targets) / sizeof(targets[0]));
+                        (unsigned char*) (providerTargets ? providerTargets : targets),
+                        count);
 
+        free(providerTargets);
         return request->property;
     }
 
@@ -851,26 +1113,7 @@ static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
 
         for (i = 0;  i < count;  i += 2)
         {
-            int j;
-
-            for (j = 0;  j < formatCount;  j++)
-            {
-                if (targets[i] == formats[j])
-                    break;
-            }
-
-            if (j < formatCount)
-            {
-                XChangeProperty(_glfw.x11.display,
-                                request->requestor,
-                                targets[i + 1],
-                                targets[i],
-                                8,
-                                PropModeReplace,
-                                (unsigned char *) selectionString,
-                                strlen(selectionString));
-            }
-            else
+            if (!writeDataTarget(request, targets[i + 1], targets[i]))
                 targets[i + 1] = None;
         }
 
@@ -907,24 +1150,8 @@ static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
 
     // Conversion to a data target was requested
 
-    for (i = 0;  i < formatCount;  i++)
-    {
-        if (request->target == formats[i])
-        {
-            // The requested target is one we support
-
-            XChangeProperty(_glfw.x11.display,
-                            request->requestor,
-                            request->property,
-                            request->target,
-                            8,
-                            PropModeReplace,
-                            (unsigned char *) selectionString,
-                            strlen(selectionString));
-
-            return request->property;
-        }
-    }
+    if (writeDataTarget(request, request->property, request->target))
+        return request->property;
 
     // The requested target is not supported
 
@@ -974,6 +1201,33 @@ static const char* getSelectionString(Atom selection)
     if (XGetSelectionOwner(_glfw.x11.display, selection) ==
         _glfw.x11.helperWindowHandle)
     {
+        if (selection == _glfw.x11.CLIPBOARD && _glfw.clipboardProvider.callback)
+        {
+            // The provider is only asked for the text once it is pasted
+            size_t size;
+            const char* data =
+                _glfwProvideClipboardData("text/plain;charset=utf-8", &size);
+
+            free(*selectionString);
+            *selectionString = NULL;
+
+            if (!data)
+            {
+                _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                                "X11: Failed to convert selection to string");
+                return NULL;
+            }
+
+            *selectionString = calloc(size + 1, 1);
+            if (!*selectionString)
+            {
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                return NULL;
+            }
+
+            memcpy(*selectionString, data, size);
+        }
+
         // Instead of doing a large number of X round-trips just to put this
         // string into a window property and then read it back, just return it
         return *selectionString;
@@ -1028,7 +1282,7 @@ static const char* getSelectionString(Atom selection)
 
         if (actualType == _glfw.x11.INCR)
         {
-            size_t size = 1;
+            size_t size = 0;
             char* string = NULL;
 
             for (;;)
@@ -1057,10 +1311,10 @@ static const char* getSelectionString(Atom selection)
 
                 if (itemCount)
                 {
+                    string = realloc(string, size + itemCount + 1);
+                    memcpy(string + size, data, itemCount);
                     size += itemCount;
-                    string = realloc(string, size);
-                    string[size - itemCount - 1] = '\0';
-                    strcat(string, data);
+                    string[size] = '\0';
                 }
 
                 if (!itemCount)
@@ -1100,6 +1354,154 @@ static const char* getSelectionString(Atom selection)
     return *selectionString;
 }
 
+// Converts the clipboard to the current target of the asynchronous request
+//
+static void convertClipboardRequest(void)
+{
+    const Atom targets[] = { _glfw.x11.UTF8_STRING, XA_STRING };
+
+    XConvertSelection(_glfw.x11.display,
+                      _glfw.x11.CLIPBOARD,
+                      targets[_glfw.x11.clipboardRequest.target],
+                      _glfw.x11.GLFW_SELECTION,
+                      _glfw.x11.clipboardRequestHandle,
+                      CurrentTime);
+    XFlush(_glfw.x11.display);
+}
+
+// Ends the asynchronous clipboard request and delivers its result
+//
+static void endClipboardRequest(char* string)
+{
+    free(_glfw.x11.clipboardRequest.data);
+    memset(&_glfw.x11.clipboardRequest, 0, sizeof(_glfw.x11.clipboardRequest));
+
+    _glfwInputClipboardString(string);
+    free(string);
+}
+
+// Handles an event for the asynchronous clipboard request helper window
+//
+static void handleClipboardRequestEvent(const XEvent* event)
+{
+    const Atom targets[] = { _glfw.x11.UTF8_STRING, XA_STRING };
+    const int targetCount = sizeof(targets) / sizeof(targets[0]);
+    const Atom target = targets[_glfw.x11.clipboardRequest.target];
+    char* data;
+    Atom actualType;
+    int actualFormat;
+    unsigned long itemCount, bytesAfter;
+
+    if (!_glfw.x11.clipboardRequest.active)
+        return;
+
+    if (event->type == SelectionNotify)
+    {
+        if (event->xselection.property != None)
+        {
+            XGetWindowProperty(_glfw.x11.display,
+                               event->xselection.requestor,
+                               event->xselection.property,
+                               0,
+                               LONG_MAX,
+                               True,
+                               AnyPropertyType,
+                               &actualType,
+                               &actualFormat,
+                               &itemCount,
+                               &bytesAfter,
+                               (unsigned char**) &data);
+
+            if (actualType == _glfw.x11.INCR)
+            {
+                // The data will arrive in chunks as property changes
+                _glfw.x11.clipboardRequest.incremental = GLFW_TRUE;
+                XFree(data);
+                return;
+            }
+
+            if (actualType == target)
+            {
+                char* string;
+                if (target == XA_STRING)
+                    string = convertLatin1toUTF8(data);
+                else
+                    string = _glfw_strdup(data);
+
+                XFree(data);
+                endClipboardRequest(string);
+                return;
+            }
+
+            if (data)
+                XFree(data);
+        }
+
+        // The owner could not convert to this target, so try the next one
+        if (++_glfw.x11.clipboardRequest.target < targetCount)
+            convertClipboardRequest();
+        else
+            endClipboardRequest(NULL);
+    }
+    else if (event->type == PropertyNotify)
+    {
+        if (!_glfw.x11.clipboardRequest.incremental ||
+            event->xproperty.state != PropertyNewValue ||
+            event->xproperty.atom != _glfw.x11.GLFW_SELECTION)
+        {
+            return;
+        }
+
+        XGetWindowProperty(_glfw.x11.display,
+                           event->xproperty.window,
+                           event->xproperty.atom,
+                           0,
+                           LONG_MAX,
+                           True,
+                           AnyPropertyType,
+                           &actualType,
+                           &actualFormat,
+                           &itemCount,
+                           &bytesAfter,
+                           (unsigned char**) &data);
+
+        if (itemCount)
+        {
+            const size_t size = _glfw.x11.clipboardRequest.size;
+            char* string = realloc(_glfw.x11.clipboardRequest.data,
+                                   size + itemCount + 1);
+            if (string)
+            {
+                memcpy(string + size, data, itemCount);
+                string[size + itemCount] = '\0';
+                _glfw.x11.clipboardRequest.data = string;
+                _glfw.x11.clipboardRequest.size += itemCount;
+            }
+            else
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+
+            XFree(data);
+            return;
+        }
+
+        if (data)
+            XFree(data);
+
+        // A zero-length chunk ends the transfer
+        char* string = _glfw.x11.clipboardRequest.data;
+        _glfw.x11.clipboardRequest.data = NULL;
+
+        if (string && target == XA_STRING)
+        {
+            char* converted = convertLatin1toUTF8(string);
+            free(string);
+            string = converted;
+        }
+
+        endClipboardRequest(string);
+    }
+}
+
 // Make the specified window and its video mode active on its monitor
 //
 static void acquireMonitor(_GLFWwindow* window)
@@ -1195,6 +1597,17 @@ static void processEvent(XEvent *event)
             {
                 _glfw.x11.xkb.group = ((XkbEvent*) event)->state.group;
             }
+            else if (((XkbEvent*) event)->any.xkb_type == XkbNewKeyboardNotify)
+            {
+                // A different keymap may have been loaded
+                _glfwUpdateKeyTablesX11(GLFW_TRUE);
+            }
+            else if (((XkbEvent*) event)->any.xkb_type == XkbMapNotify)
+            {
+                // The current keymap was modified in place
+                XkbRefreshKeyboardMapping(&((XkbEvent*) event)->map);
+                _glfwUpdateKeyTablesX11(GLFW_FALSE);
+            }
 
             return;
         }
@@ -1248,6 +1661,19 @@ static void processEvent(XEvent *event)
         handleSelectionRequest(event);
         return;
     }
+    else if (_glfw.x11.clipboardRequestHandle &&
+             event->xany.window == _glfw.x11.clipboardRequestHandle)
+    {
+        // This is checked before transfers so that the property changes of
+        // the request are never mistaken for those of a transfer
+        handleClipboardRequestEvent(event);
+        return;
+    }
+    else if (isTransferEvent(_glfw.x11.display, event, NULL))
+    {
+        handleTransferEvent(event);
+        return;
+    }
 
     _GLFWwindow* window = NULL;
     if (XFindContext(_glfw.x11.display,
@@ -1303,6 +1729,12 @@ static void processEvent(XEvent *event)
                     if (status == XBufferOverflow)
                     {
                         chars = calloc(count + 1, 1);
+                        if (!chars)
+                        {
+                            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                            return;
+                        }
+
                         count = Xutf8LookupString(window->x11.ic,
                                                   &event->xkey,
                                                   chars, count,
@@ -1311,10 +1743,29 @@ static void processEvent(XEvent *event)
 
                     if (status == XLookupChars || status == XLookupBoth)
                     {
+                        // There are at most as many code points as bytes
+                        unsigned int stackCodepoints[sizeof(buffer)];
+                        unsigned int* codepoints = stackCodepoints;
+                        int codepointCount = 0;
                         const char* c = chars;
-                        chars[count] = '\0';
-                        while (c - chars < count)
-                            _glfwInputChar(window, decodeUTF8(&c), mods, plain);
+
+                        if (count > (int) sizeof(buffer))
+                            codepoints = calloc(count, sizeof(unsigned int));
+
+                        if (codepoints)
+                        {
+                            chars[count] = '\0';
+                            while (c - chars < count)
+                                codepoints[codepointCount++] = decodeUTF8(&c);
+
+                            _glfwInputText(window, codepoints, codepointCount,
+                                           mods, plain);
+
+                            if (codepoints != stackCodepoints)
+                                free(codepoints);
+                        }
+                        else
+                            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
                     }
 #else /*X_HAVE_UTF8_STRING*/
                     wchar_t buffer[16];
@@ -1330,6 +1781,12 @@ static void processEvent(XEvent *event)
                     if (status == XBufferOverflow)
                     {
                         chars = calloc(count, sizeof(wchar_t));
+                        if (!chars)
+                        {
+                            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                            return;
+                        }
+
                         count = XwcLookupString(window->x11.ic,
                                                 &event->xkey,
                                                 chars, count,
@@ -1339,8 +1796,20 @@ static void processEvent(XEvent *event)
                     if (status == XLookupChars || status == XLookupBoth)
                     {
                         int i;
-                        for (i = 0;  i < count;  i++)
-                            _glfwInputChar(window, chars[i], mods, plain);
+                        unsigned int* codepoints =
+                            calloc(count, sizeof(unsigned int));
+
+                        if (codepoints)
+                        {
+                            for (i = 0;  i < count;  i++)
+                                codepoints[i] = chars[i];
+
+                            _glfwInputText(window, codepoints, count,
+                                           mods, plain);
+                            free(codepoints);
+                        }
+                        else
+                            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
                     }
 #endif /*X_HAVE_UTF8_STRING*/
 
@@ -1753,16 +2222,7 @@ static void processEvent(XEvent *event)
                                               (unsigned char**) &data);
 
                 if (result)
-                {
-                    int i, count;
-                    char** paths = parseUriList(data, &count);
-
-                    _glfwInputDrop(window, count, (const char**) paths);
-
-                    for (i = 0;  i < count;  i++)
-                        free(paths[i]);
-                    free(paths);
-                }
+                    _glfwInputDropUriList(window, data, GLFW_TRUE);
 
                 if (data)
                     XFree(data);
@@ -1965,6 +2425,10 @@ void _glfwPushSelectionToManagerX11(void)
             }
         }
 
+        // The clipboard manager may receive large selections incrementally
+        while (XCheckIfEvent(_glfw.x11.display, &event, isTransferEvent, NULL))
+            handleTransferEvent(&event);
+
         waitForEvent(NULL);
     }
 }
@@ -2114,12 +2578,18 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
 {
     if (count)
     {
-        int i, j, longCount = 0;
+        int i, longCount = 0;
 
         for (i = 0;  i < count;  i++)
             longCount += 2 + images[i].width * images[i].height;
 
         long* icon = calloc(longCount, sizeof(long));
+        if (!icon)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+
         long* target = icon;
 
         for (i = 0;  i < count;  i++)
@@ -2127,13 +2597,11 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
             *target++ = images[i].width;
             *target++ = images[i].height;
 
-            for (j = 0;  j < images[i].width * images[i].height;  j++)
-            {
-                *target++ = (images[i].pixels[j * 4 + 0] << 16) |
-                            (images[i].pixels[j * 4 + 1] <<  8) |
-                            (images[i].pixels[j * 4 + 2] <<  0) |
-                            (images[i].pixels[j * 4 + 3] << 24);
-            }
+            // The icon property holds one non-premultiplied ARGB pixel per long
+            _glfwConvertImage(images + i, _glfw.hints.imageFormat,
+                              _GLFW_PIXELS_ARGB_LONG, GLFW_FALSE, target);
+
+            target += images[i].width * images[i].height;
         }
 
         XChangeProperty(_glfw.x11.display, window->x11.handle,
@@ -2455,6 +2923,10 @@ void _glfwPlatformRequestWindowAttention(_GLFWwindow* window)
                   0, 1, 0);
 }
 
+void _glfwPlatformRequestWindowFrame(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformFocusWindow(_GLFWwindow* window)
 {
     if (_glfw.x11.NET_ACTIVE_WINDOW)
@@ -2738,6 +3210,10 @@ void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity)
                     PropModeReplace, (unsigned char*) &value, 1);
 }
 
+void _glfwPlatformSetWindowRenderScale(_GLFWwindow* window, float scale)
+{
+}
+
 void _glfwPlatformSetRawMouseMotion(_GLFWwindow *window, GLFWbool enabled)
 {
     if (!_glfw.x11.xi.available)
@@ -2757,12 +3233,26 @@ GLFWbool _glfwPlatformRawMouseMotionSupported(void)
     return _glfw.x11.xi.available;
 }
 
+void _glfwPlatformUpdateTextInput(_GLFWwindow* window)
+{
+    // The input context is created here rather than on the first key press,
+    // as that key press has already been passed to XFilterEvent
+    updateInputContext(window);
+
+    if (window->x11.ic && _glfwPlatformWindowFocused(window))
+        XSetICFocus(window->x11.ic);
+}
+
 void _glfwPlatformPollEvents(void)
 {
     _GLFWwindow* window;
 
 #if defined(__linux__)
-    _glfwDetectJoystickConnectionLinux();
+    if (_glfw.joysticksInitialized)
+    {
+        _glfwDetectJoystickConnectionLinux();
+        _glfwPollJoysticksLinux();
+    }
 #endif
     XPending(_glfw.x11.display);
 
@@ -2793,20 +3283,13 @@ void _glfwPlatformPollEvents(void)
 
 void _glfwPlatformWaitEvents(void)
 {
-    while (!XPending(_glfw.x11.display))
-        waitForEvent(NULL);
-
+    waitForAnyEvent(NULL);
     _glfwPlatformPollEvents();
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
-    while (!XPending(_glfw.x11.display))
-    {
-        if (!waitForEvent(&timeout))
-            break;
-    }
-
+    waitForAnyEvent(&timeout);
     _glfwPlatformPollEvents();
 }
 
@@ -2876,22 +3359,14 @@ const char* _glfwPlatformGetScancodeName(int scancode)
         return NULL;
     }
 
-    const int key = _glfw.x11.keycodes[scancode];
-    const KeySym keysym = XkbKeycodeToKeysym(_glfw.x11.display,
-                                             scancode, _glfw.x11.xkb.group, 0);
-    if (keysym == NoSymbol)
-        return NULL;
+    const unsigned int group = _glfw.x11.xkb.group % XkbNumKbdGroups;
+    if (!_glfw.x11.keynamesValid[group])
+        updateKeyNames(group);
 
-    const long ch = _glfwKeySym2Unicode(keysym);
-    if (ch == -1)
+    if (_glfw.x11.keynames[group][scancode][0] == '\0')
         return NULL;
 
-    const size_t count = encodeUTF8(_glfw.x11.keynames[key], (unsigned int) ch);
-    if (count == 0)
-        return NULL;
-
-    _glfw.x11.keynames[key][count] = '\0';
-    return _glfw.x11.keynames[key];
+    return _glfw.x11.keynames[group][scancode];
 }
 
 int _glfwPlatformGetKeyScancode(int key)
@@ -2903,7 +3378,8 @@ int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
                               const GLFWimage* image,
                               int xhot, int yhot)
 {
-    cursor->x11.handle = _glfwCreateCursorX11(image, xhot, yhot);
+    cursor->x11.handle =
+        _glfwCreateCursorX11(image, cursor->format, xhot, yhot);
     if (!cursor->x11.handle)
         return GLFW_FALSE;
 
@@ -2979,6 +3455,81 @@ const char* _glfwPlatformGetClipboardString(void)
     return getSelectionString(_glfw.x11.CLIPBOARD);
 }
 
+GLFWbool _glfwPlatformSetClipboardProvider(void)
+{
+    const int count = _glfw.clipboardProvider.typeCount;
+    Atom* targets = calloc(count, sizeof(Atom));
+    if (!targets)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        _glfwClearClipboardProvider();
+        return GLFW_TRUE;
+    }
+
+    // Each MIME type is offered as a target of the same name
+    XInternAtoms(_glfw.x11.display,
+                 _glfw.clipboardProvider.types, count,
+                 False, targets);
+
+    free(_glfw.x11.clipboardTargets);
+    _glfw.x11.clipboardTargets = targets;
+
+    free(_glfw.x11.clipboardString);
+    _glfw.x11.clipboardString = NULL;
+
+    XSetSelectionOwner(_glfw.x11.display,
+                       _glfw.x11.CLIPBOARD,
+                       _glfw.x11.helperWindowHandle,
+                       CurrentTime);
+
+    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) !=
+        _glfw.x11.helperWindowHandle)
+    {
+        // The provider would never be asked for its contents
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to become owner of clipboard selection");
+        _glfwClearClipboardProvider();
+    }
+
+    return GLFW_TRUE;
+}
+
+GLFWbool _glfwPlatformRequestClipboardString(void)
+{
+    // When we own the clipboard, shared code retrieves the local contents
+    // without a round-trip through the X server
+    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) ==
+        _glfw.x11.helperWindowHandle)
+    {
+        return GLFW_FALSE;
+    }
+
+    if (!_glfw.x11.clipboardRequestHandle)
+    {
+        // A separate requestor window keeps the events of this transfer apart
+        // from those of glfwGetClipboardString
+        _glfw.x11.clipboardRequestHandle = _glfwCreateHelperWindowX11();
+    }
+
+    _glfw.x11.clipboardRequest.active = GLFW_TRUE;
+    convertClipboardRequest();
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformCancelClipboardRequest(void)
+{
+    // Destroying the requestor window discards any events of the abandoned
+    // conversion that are still on their way
+    if (_glfw.x11.clipboardRequestHandle)
+    {
+        XDestroyWindow(_glfw.x11.display, _glfw.x11.clipboardRequestHandle);
+        _glfw.x11.clipboardRequestHandle = None;
+    }
+
+    free(_glfw.x11.clipboardRequest.data);
+    memset(&_glfw.x11.clipboardRequest, 0, sizeof(_glfw.x11.clipboardRequest));
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface)
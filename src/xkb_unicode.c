@@ -29,6 +29,10 @@
 
 #include "internal.h"
 
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
 
 /*
  * Marcus: This code was originally written by Markus G. Kuhn.
@@ -41,9 +45,11 @@
  * (UCS, Unicode) values.
  *
  * The array keysymtab[] contains pairs of X11 keysym values for graphical
- * characters and the corresponding Unicode value. The function
- * _glfwKeySym2Unicode() maps a keysym onto a Unicode value using a binary
- * search, therefore keysymtab[] must remain SORTED by keysym value.
+ * characters and the corresponding Unicode value. On first use it is
+ * expanded into a two-level direct-index table, keyed on the high and low
+ * bytes of the keysym, so that _glfwKeySym2Unicode() is a pair of array
+ * lookups. The table must still remain SORTED by keysym value and free of
+ * duplicates, as the expansion asserts this.
  *
  * We allow to represent any UCS character in the range U-00000000 to
  * U-00FFFFFF by a keysym value in the range 0x01000000 to 0x01ffffff.
@@ -901,6 +907,79 @@ static const struct codepair {
 };
 
 
+// Second level of the lookup table, one page per distinct high keysym byte
+// used by keysymtab[], indexed by the low keysym byte
+// A zero entry means there is no mapping, as no keysym maps to U+0000
+//
+static unsigned short (*keysymPages)[256];
+
+// First level of the lookup table, indexed by the high keysym byte
+// A zero entry means the page is empty, otherwise it is the page index plus one
+//
+static unsigned short keysymPageIndex[256];
+
+// Expands keysymtab[] into the two-level direct-index table, returning whether
+// the pages could be allocated
+//
+static GLFWbool buildKeysymPages(void)
+{
+    const size_t count = sizeof(keysymtab) / sizeof(keysymtab[0]);
+    unsigned int pageCount = 0;
+
+    // The pages are counted first so that the table is sized from keysymtab[]
+    for (size_t i = 0;  i < count;  i++)
+    {
+        const unsigned int high = keysymtab[i].keysym >> 8;
+
+        assert(i == 0 || keysymtab[i - 1].keysym < keysymtab[i].keysym);
+        assert(keysymtab[i].ucs != 0);
+
+        if (!keysymPageIndex[high])
+            keysymPageIndex[high] = ++pageCount;
+    }
+
+    keysymPages = calloc(pageCount, sizeof(keysymPages[0]));
+    if (!keysymPages)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        memset(keysymPageIndex, 0, sizeof(keysymPageIndex));
+        return GLFW_FALSE;
+    }
+
+    for (size_t i = 0;  i < count;  i++)
+    {
+        const unsigned int high = keysymtab[i].keysym >> 8;
+        const unsigned int low = keysymtab[i].keysym & 0xff;
+
+        keysymPages[keysymPageIndex[high] - 1][low] = keysymtab[i].ucs;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Finds the keysym in keysymtab[] with a binary search
+// This is only used if the direct-index table could not be allocated
+//
+static long searchKeysymTable(unsigned int keysym)
+{
+    int min = 0;
+    int max = sizeof(keysymtab) / sizeof(struct codepair) - 1;
+
+    while (max >= min)
+    {
+        const int mid = (min + max) / 2;
+        if (keysymtab[mid].keysym < keysym)
+            min = mid + 1;
+        else if (keysymtab[mid].keysym > keysym)
+            max = mid - 1;
+        else
+            return keysymtab[mid].ucs;
+    }
+
+    return -1;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -909,10 +988,6 @@ static const struct codepair {
 //
 long _glfwKeySym2Unicode(unsigned int keysym)
 {
-    int min = 0;
-    int max = sizeof(keysymtab) / sizeof(struct codepair) - 1;
-    int mid;
-
     // First check for Latin-1 characters (1:1 mapping)
     if ((keysym >= 0x0020 && keysym <= 0x007e) ||
         (keysym >= 0x00a0 && keysym <= 0x00ff))
@@ -924,19 +999,30 @@ long _glfwKeySym2Unicode(unsigned int keysym)
     if ((keysym & 0xff000000) == 0x01000000)
         return keysym & 0x00ffffff;
 
-    // Binary search in table
-    while (max >= min)
-    {
-        mid = (min + max) / 2;
-        if (keysymtab[mid].keysym < keysym)
-            min = mid + 1;
-        else if (keysymtab[mid].keysym > keysym)
-            max = mid - 1;
-        else
-            return keysymtab[mid].ucs;
-    }
+    // All other tabled keysyms fit in 16 bits
+    if (keysym > 0xffff)
+        return -1;
 
-    // No matching Unicode value found
-    return -1;
+    if (!keysymPages && !buildKeysymPages())
+        return searchKeysymTable(keysym);
+
+    const unsigned int page = keysymPageIndex[keysym >> 8];
+    if (!page)
+        return -1;
+
+    const unsigned short ucs = keysymPages[page - 1][keysym & 0xff];
+    if (!ucs)
+        return -1;
+
+    return ucs;
+}
+
+// Frees the direct-index table
+//
+void _glfwTerminateKeySym2Unicode(void)
+{
+    free(keysymPages);
+    keysymPages = NULL;
+    memset(keysymPageIndex, 0, sizeof(keysymPageIndex));
 }
 
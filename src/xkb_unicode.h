@@ -25,4 +25,5 @@
 //========================================================================
 
 long _glfwKeySym2Unicode(unsigned int keysym);
+void _glfwTerminateKeySym2Unicode(void);
 
@@ -447,6 +447,13 @@ static void char_callback(GLFWwindow* window, unsigned int codepoint)
            counter++, slot->number, glfwGetTime(), codepoint, string);
 }
 
+static void text_callback(GLFWwindow* window, const char* text)
+{
+    Slot* slot = glfwGetWindowUserPointer(window);
+    printf("%08x to %i at %0.3f: Text (%s) input\n",
+           counter++, slot->number, glfwGetTime(), text);
+}
+
 static void drop_callback(GLFWwindow* window, int count, const char* paths[])
 {
     int i;
@@ -511,6 +518,25 @@ static void joystick_callback(int jid, int event)
     }
 }
 
+static void joystick_axis_callback(int jid, int axis, float value)
+{
+    printf("%08x at %0.3f: Joystick %i axis %i moved to %0.3f\n",
+           counter++, glfwGetTime(), jid, axis, value);
+}
+
+static void joystick_button_callback(int jid, int button, int action)
+{
+    printf("%08x at %0.3f: Joystick %i button %i was %s\n",
+           counter++, glfwGetTime(), jid, button,
+           get_action_name(action));
+}
+
+static void joystick_hat_callback(int jid, int hat, int state)
+{
+    printf("%08x at %0.3f: Joystick %i hat %i changed to 0x%x\n",
+           counter++, glfwGetTime(), jid, hat, state);
+}
+
 int main(int argc, char** argv)
 {
     Slot* slots;
@@ -526,6 +552,9 @@ int main(int argc, char** argv)
 
     glfwSetMonitorCallback(monitor_callback);
     glfwSetJoystickCallback(joystick_callback);
+    glfwSetJoystickAxisCallback(joystick_axis_callback);
+    glfwSetJoystickButtonCallback(joystick_button_callback);
+    glfwSetJoystickHatCallback(joystick_hat_callback);
 
     while ((ch = getopt(argc, argv, "hfn:")) != -1)
     {
@@ -617,6 +646,7 @@ int main(int argc, char** argv)
         glfwSetScrollCallback(slots[i].window, scroll_callback);
         glfwSetKeyCallback(slots[i].window, key_callback);
         glfwSetCharCallback(slots[i].window, char_callback);
+        glfwSetTextCallback(slots[i].window, text_callback);
         glfwSetDropCallback(slots[i].window, drop_callback);
 
         glfwMakeContextCurrent(slots[i].window);
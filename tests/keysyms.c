@@ -0,0 +1,134 @@
+//========================================================================
+// Keysym to Unicode conversion test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test checks that the direct-index keysym table gives the same result
+// as the binary search of keysymtab[] it replaced
+//
+// Every keysym up to the end of the directly encoded UCS range is compared,
+// followed by a sample of the rest of the 32-bit range
+//
+// It includes the library source, as the table is internal
+//
+//========================================================================
+
+#include "xkb_unicode.c"
+
+#include <stdio.h>
+
+// The library source reports errors through shared code, which is not linked
+//
+void _glfwInputError(int code, const char* format, ...)
+{
+}
+
+// This is _glfwKeySym2Unicode as it was before the direct-index table
+//
+static long reference_keysym_to_unicode(unsigned int keysym)
+{
+    int min = 0;
+    int max = sizeof(keysymtab) / sizeof(struct codepair) - 1;
+    int mid;
+
+    // First check for Latin-1 characters (1:1 mapping)
+    if ((keysym >= 0x0020 && keysym <= 0x007e) ||
+        (keysym >= 0x00a0 && keysym <= 0x00ff))
+    {
+        return keysym;
+    }
+
+    // Also check for directly encoded 24-bit UCS characters
+    if ((keysym & 0xff000000) == 0x01000000)
+        return keysym & 0x00ffffff;
+
+    // Binary search in table
+    while (max >= min)
+    {
+        mid = (min + max) / 2;
+        if (keysymtab[mid].keysym < keysym)
+            min = mid + 1;
+        else if (keysymtab[mid].keysym > keysym)
+            max = mid - 1;
+        else
+            return keysymtab[mid].ucs;
+    }
+
+    // No matching Unicode value found
+    return -1;
+}
+
+static int errors = 0;
+
+static void check_keysym(unsigned int keysym)
+{
+    const long expected = reference_keysym_to_unicode(keysym);
+    const long actual = _glfwKeySym2Unicode(keysym);
+
+    if (actual == expected)
+        return;
+
+    if (errors < 8)
+    {
+        printf("Keysym 0x%08x maps to %li, expected %li\n",
+               keysym, actual, expected);
+    }
+
+    errors++;
+}
+
+int main(void)
+{
+    unsigned int keysym;
+
+    for (keysym = 0;  keysym <= 0x01ffffff;  keysym++)
+        check_keysym(keysym);
+
+    for (keysym = 0x02000000;  keysym >= 0x02000000;  keysym += 0xfff1)
+        check_keysym(keysym);
+
+    check_keysym(0xffffffff);
+
+    // The binary search used when the table cannot be allocated must agree as
+    // well, for the keysyms above Latin-1 that it is used for
+    for (keysym = 0x100;  keysym <= 0xffff;  keysym++)
+    {
+        if (searchKeysymTable(keysym) != reference_keysym_to_unicode(keysym))
+        {
+            printf("Fallback search maps keysym 0x%04x incorrectly\n", keysym);
+            errors++;
+        }
+    }
+
+    _glfwTerminateKeySym2Unicode();
+
+    if (errors)
+    {
+        printf("%i keysyms converted incorrectly\n", errors);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("All keysyms match the reference\n");
+    exit(EXIT_SUCCESS);
+}
+
@@ -0,0 +1,255 @@
+//========================================================================
+// Image pixel conversion test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test checks the pixel conversion used for cursors and window icons
+// against a straightforward reference implementation
+//
+// Every combination of source format, target layout and alpha mode is
+// converted for every pair of 8-bit channel and alpha values
+//
+// It is built from the library sources, as the conversion is internal
+//
+//========================================================================
+
+#include "internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const int formats[] =
+{
+    GLFW_IMAGE_RGBA,
+    GLFW_IMAGE_BGRA_PREMULTIPLIED
+};
+
+static const int layouts[] =
+{
+    _GLFW_PIXELS_RGBA,
+    _GLFW_PIXELS_BGRA,
+    _GLFW_PIXELS_ARGB,
+    _GLFW_PIXELS_ARGB_LONG
+};
+
+static const char* get_format_name(int format)
+{
+    if (format == GLFW_IMAGE_BGRA_PREMULTIPLIED)
+        return "premultiplied BGRA";
+
+    return "RGBA";
+}
+
+static const char* get_layout_name(int layout)
+{
+    switch (layout)
+    {
+        case _GLFW_PIXELS_RGBA:
+            return "RGBA";
+        case _GLFW_PIXELS_BGRA:
+            return "BGRA";
+        case _GLFW_PIXELS_ARGB:
+            return "ARGB";
+        case _GLFW_PIXELS_ARGB_LONG:
+            return "ARGB long";
+    }
+
+    return "unknown";
+}
+
+// Returns x * a / 255 rounded to nearest
+//
+static unsigned int premultiply(unsigned int x, unsigned int a)
+{
+    return (2 * x * a + 255) / 510;
+}
+
+// Returns x * 255 / a rounded to nearest, clamped to the channel range
+//
+static unsigned int unpremultiply(unsigned int x, unsigned int a)
+{
+    unsigned int value;
+
+    if (a == 0)
+        return 0;
+
+    value = (2 * x * 255 + a) / (2 * a);
+    return value > 255 ? 255 : value;
+}
+
+// Returns the source color channels for the specified channel value, with each
+// channel taking a different value
+//
+static void get_source_pixel(unsigned int x,
+                             unsigned int* r, unsigned int* g,
+                             unsigned int* b)
+{
+    *r = x;
+    *g = 255 - x;
+    *b = x ^ 0xa5;
+}
+
+static void read_target_pixel(const void* target, int layout, int index,
+                              unsigned int* r, unsigned int* g,
+                              unsigned int* b, unsigned int* a)
+{
+    if (layout == _GLFW_PIXELS_ARGB)
+    {
+        const uint32_t value = ((const uint32_t*) target)[index];
+        *a = (value >> 24) & 0xff;
+        *r = (value >> 16) & 0xff;
+        *g = (value >> 8) & 0xff;
+        *b = value & 0xff;
+    }
+    else if (layout == _GLFW_PIXELS_ARGB_LONG)
+    {
+        const unsigned long value = ((const unsigned long*) target)[index];
+        *a = (value >> 24) & 0xff;
+        *r = (value >> 16) & 0xff;
+        *g = (value >> 8) & 0xff;
+        *b = value & 0xff;
+    }
+    else
+    {
+        const unsigned char* pixel = (const unsigned char*) target + index * 4;
+
+        if (layout == _GLFW_PIXELS_BGRA)
+        {
+            *r = pixel[2];
+            *b = pixel[0];
+        }
+        else
+        {
+            *r = pixel[0];
+            *b = pixel[2];
+        }
+
+        *g = pixel[1];
+        *a = pixel[3];
+    }
+}
+
+static int test_conversion(int format, int layout, GLFWbool premultiplied)
+{
+    int x, a, errors = 0;
+    static unsigned char pixels[256 * 256 * 4];
+    static unsigned long target[256 * 256];
+    const GLFWimage image = { 256, 256, pixels };
+
+    for (a = 0;  a < 256;  a++)
+    {
+        for (x = 0;  x < 256;  x++)
+        {
+            unsigned char* pixel = pixels + (a * 256 + x) * 4;
+            unsigned int r, g, b;
+
+            get_source_pixel(x, &r, &g, &b);
+
+            if (format == GLFW_IMAGE_BGRA_PREMULTIPLIED)
+            {
+                pixel[0] = (unsigned char) b;
+                pixel[1] = (unsigned char) g;
+                pixel[2] = (unsigned char) r;
+            }
+            else
+            {
+                pixel[0] = (unsigned char) r;
+                pixel[1] = (unsigned char) g;
+                pixel[2] = (unsigned char) b;
+            }
+
+            pixel[3] = (unsigned char) a;
+        }
+    }
+
+    _glfwConvertImage(&image, format, layout, premultiplied, target);
+
+    for (a = 0;  a < 256;  a++)
+    {
+        for (x = 0;  x < 256;  x++)
+        {
+            unsigned int source[3], expected[4], actual[4];
+            int i;
+
+            get_source_pixel(x, source + 0, source + 1, source + 2);
+
+            for (i = 0;  i < 3;  i++)
+            {
+                if (format == GLFW_IMAGE_RGBA && premultiplied)
+                    expected[i] = premultiply(source[i], a);
+                else if (format == GLFW_IMAGE_BGRA_PREMULTIPLIED && !premultiplied)
+                    expected[i] = unpremultiply(source[i], a);
+                else
+                    expected[i] = source[i];
+            }
+
+            expected[3] = a;
+
+            read_target_pixel(target, layout, a * 256 + x,
+                              actual + 0, actual + 1, actual + 2, actual + 3);
+
+            for (i = 0;  i < 4;  i++)
+            {
+                if (actual[i] == expected[i])
+                    continue;
+
+                if (errors < 8)
+                {
+                    printf("%s to %s%s: channel %i of value %i alpha %i is %u, expected %u\n",
+                           get_format_name(format),
+                           get_layout_name(layout),
+                           premultiplied ? " premultiplied" : "",
+                           i, x, a, actual[i], expected[i]);
+                }
+
+                errors++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+int main(void)
+{
+    int i, j, errors = 0;
+
+    for (i = 0;  i < sizeof(formats) / sizeof(formats[0]);  i++)
+    {
+        for (j = 0;  j < sizeof(layouts) / sizeof(layouts[0]);  j++)
+        {
+            errors += test_conversion(formats[i], layouts[j], GLFW_FALSE);
+            errors += test_conversion(formats[i], layouts[j], GLFW_TRUE);
+        }
+    }
+
+    if (errors)
+    {
+        printf("%i channels converted incorrectly\n", errors);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("All conversions match the reference\n");
+    exit(EXIT_SUCCESS);
+}
+
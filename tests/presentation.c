@@ -0,0 +1,137 @@
+//========================================================================
+// Presentation time test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test swaps a window every frame and prints the presentation time,
+// refresh period and retrace counter of each frame reported as shown, along
+// with how far apart consecutive reported frames were
+//
+//========================================================================
+
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// The number of frames swapped before a lack of reports is pointed out
+#define REPORT_GRACE_FRAMES 120
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
+}
+
+int main(void)
+{
+    GLFWwindow* window;
+    unsigned long frame = 0, reported = 0;
+    double lastTime = 0.0;
+    uint64_t lastSequence = 0;
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    window = glfwCreateWindow(640, 480, "Presentation Time Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGL(glfwGetProcAddress);
+    glfwSwapInterval(1);
+    glfwSetKeyCallback(window, key_callback);
+
+    while (!glfwWindowShouldClose(window))
+    {
+        int width, height;
+        double time, refresh;
+        uint64_t sequence;
+        const float shade = (frame & 1) ? 0.6f : 0.4f;
+
+        glfwGetFramebufferSize(window, &width, &height);
+
+        glViewport(0, 0, width, height);
+        glClearColor(shade, shade, shade, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glfwSwapBuffers(window);
+        frame++;
+
+        glfwPollEvents();
+
+        if (!glfwGetWindowPresentationTime(window, &time, &refresh, &sequence))
+        {
+            if (frame == REPORT_GRACE_FRAMES)
+            {
+                printf("No presentation reported after %i frames; it may not "
+                       "be supported on this platform\n",
+                       REPORT_GRACE_FRAMES);
+            }
+
+            continue;
+        }
+
+        // The same frame stays reported until a newer one has been shown
+        if (time == lastTime && sequence == lastSequence)
+            continue;
+
+        if (reported)
+        {
+            printf("Frame %lu: shown at %.6f, refresh %.3f ms, sequence %" PRIu64
+                   " (+%" PRIu64 "), %.3f ms after the previous one\n",
+                   frame, time, refresh * 1000.0, sequence,
+                   sequence - lastSequence, (time - lastTime) * 1000.0);
+        }
+        else
+        {
+            printf("Frame %lu: shown at %.6f, refresh %.3f ms, sequence %" PRIu64
+                   "\n",
+                   frame, time, refresh * 1000.0, sequence);
+        }
+
+        lastTime = time;
+        lastSequence = sequence;
+        reported++;
+    }
+
+    printf("%lu of %lu swapped frames were reported as shown\n", reported, frame);
+
+    glfwDestroyWindow(window);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
+
@@ -0,0 +1,361 @@
+//========================================================================
+// Virtual joystick test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test creates a virtual joystick, drives its axes, buttons and hat and
+// checks the reported state, the joystick callbacks and the gamepad state
+// produced by a mapping matching its GUID, including a hat element whose mask
+// has more than one bit
+//
+// It needs no joystick hardware and exits with 77, the usual code for
+// a skipped test, if GLFW cannot be initialized
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_NAME "GLFW Virtual Test Pad"
+#define TEST_GUID "78696e70757430317669727475616c00"
+
+#define AXIS_COUNT 6
+#define BUTTON_COUNT 11
+#define HAT_COUNT 1
+
+static const char* mapping =
+    TEST_GUID ",Virtual Gamepad,"
+    "a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,"
+    "guide:h0.12,leftstick:b9,rightstick:b10,"
+    "dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,"
+    "leftx:a0,lefty:a1,lefttrigger:a2,rightx:a3,righty:a4,righttrigger:a5,";
+
+static struct
+{
+    int count;
+    int jid;
+    int index;
+    int event;
+    float value;
+} last;
+
+static int errors = 0;
+
+static void check(int condition, const char* description)
+{
+    if (condition)
+        return;
+
+    printf("Failed: %s\n", description);
+    errors++;
+}
+
+static void check_error(int expected, const char* description)
+{
+    const char* message;
+    const int code = glfwGetError(&message);
+
+    if (code == expected)
+        return;
+
+    if (code == GLFW_NO_ERROR)
+        printf("Failed: %s: no error emitted\n", description);
+    else
+        printf("Failed: %s: error 0x%08X: %s\n", description, code, message);
+
+    errors++;
+}
+
+static void reset_events(void)
+{
+    memset(&last, 0, sizeof(last));
+    last.jid = -1;
+}
+
+static void joystick_callback(int jid, int event)
+{
+    last.count++;
+    last.jid = jid;
+    last.event = event;
+}
+
+static void axis_callback(int jid, int axis, float value)
+{
+    last.count++;
+    last.jid = jid;
+    last.index = axis;
+    last.value = value;
+}
+
+static void button_callback(int jid, int button, int action)
+{
+    last.count++;
+    last.jid = jid;
+    last.index = button;
+    last.event = action;
+}
+
+static void hat_callback(int jid, int hat, int state)
+{
+    last.count++;
+    last.jid = jid;
+    last.index = hat;
+    last.event = state;
+}
+
+static void test_initial_state(int jid)
+{
+    int i, count;
+    const float* axes;
+    const unsigned char* buttons;
+    const unsigned char* hats;
+
+    check(glfwJoystickPresent(jid), "joystick is present");
+    check(strcmp(glfwGetJoystickName(jid), TEST_NAME) == 0, "joystick name");
+    check(strcmp(glfwGetJoystickGUID(jid), TEST_GUID) == 0, "joystick GUID");
+
+    axes = glfwGetJoystickAxes(jid, &count);
+    check(axes && count == AXIS_COUNT, "axis count");
+    for (i = 0;  axes && i < count;  i++)
+        check(axes[i] == 0.f, "axes start centered");
+
+    // Each hat is also reported as four buttons by default
+    buttons = glfwGetJoystickButtons(jid, &count);
+    check(buttons && count == BUTTON_COUNT + HAT_COUNT * 4, "button count");
+    for (i = 0;  buttons && i < count;  i++)
+        check(buttons[i] == GLFW_RELEASE, "buttons start released");
+
+    hats = glfwGetJoystickHats(jid, &count);
+    check(hats && count == HAT_COUNT, "hat count");
+    for (i = 0;  hats && i < count;  i++)
+        check(hats[i] == GLFW_HAT_CENTERED, "hats start centered");
+
+    check_error(GLFW_NO_ERROR, "querying the initial state");
+}
+
+static void test_axes(int jid)
+{
+    int count;
+    const float* axes;
+
+    reset_events();
+    glfwSetVirtualJoystickAxis(jid, 1, -0.5f);
+    check(last.count == 1 && last.jid == jid && last.index == 1 &&
+          last.value == -0.5f,
+          "axis callback reports the new position");
+
+    axes = glfwGetJoystickAxes(jid, &count);
+    check(axes && axes[1] == -0.5f, "axis position is updated");
+
+    reset_events();
+    glfwSetVirtualJoystickAxis(jid, 1, -0.5f);
+    check(last.count == 0, "axis callback is not called without a change");
+
+    reset_events();
+    glfwSetVirtualJoystickAxis(jid, 3, 2.f);
+    check(last.count == 1 && last.value == 1.f,
+          "axis callback reports the clamped position");
+
+    axes = glfwGetJoystickAxes(jid, &count);
+    check(axes && axes[3] == 1.f, "axis position is clamped");
+
+    check_error(GLFW_NO_ERROR, "setting valid axis positions");
+
+    reset_events();
+    glfwSetVirtualJoystickAxis(jid, AXIS_COUNT, 0.5f);
+    check_error(GLFW_INVALID_VALUE, "setting an axis out of range");
+    check(last.count == 0, "axis callback is not called for invalid axes");
+}
+
+static void test_buttons(int jid)
+{
+    int count;
+    const unsigned char* buttons;
+
+    reset_events();
+    glfwSetVirtualJoystickButton(jid, 0, GLFW_PRESS);
+    check(last.count == 1 && last.jid == jid && last.index == 0 &&
+          last.event == GLFW_PRESS,
+          "button callback reports the press");
+
+    buttons = glfwGetJoystickButtons(jid, &count);
+    check(buttons && buttons[0] == GLFW_PRESS, "button state is updated");
+
+    reset_events();
+    glfwSetVirtualJoystickButton(jid, 0, GLFW_PRESS);
+    check(last.count == 0, "button callback is not called without a change");
+
+    check_error(GLFW_NO_ERROR, "setting valid button states");
+
+    reset_events();
+    glfwSetVirtualJoystickButton(jid, BUTTON_COUNT, GLFW_PRESS);
+    check_error(GLFW_INVALID_VALUE, "setting a button out of range");
+    check(last.count == 0, "button callback is not called for invalid buttons");
+}
+
+static void test_hats(int jid)
+{
+    int count;
+    const unsigned char* buttons;
+    const unsigned char* hats;
+
+    reset_events();
+    glfwSetVirtualJoystickHat(jid, 0, GLFW_HAT_LEFT_UP);
+    check(last.count == 1 && last.jid == jid && last.index == 0 &&
+          last.event == GLFW_HAT_LEFT_UP,
+          "hat callback reports the new state");
+
+    hats = glfwGetJoystickHats(jid, &count);
+    check(hats && hats[0] == GLFW_HAT_LEFT_UP, "hat state is updated");
+
+    // The hat buttons are in up, right, down, left order
+    buttons = glfwGetJoystickButtons(jid, &count);
+    check(buttons &&
+          buttons[BUTTON_COUNT + 0] == GLFW_PRESS &&
+          buttons[BUTTON_COUNT + 1] == GLFW_RELEASE &&
+          buttons[BUTTON_COUNT + 2] == GLFW_RELEASE &&
+          buttons[BUTTON_COUNT + 3] == GLFW_PRESS,
+          "hat buttons follow the hat state");
+
+    check_error(GLFW_NO_ERROR, "setting valid hat states");
+
+    reset_events();
+    glfwSetVirtualJoystickHat(jid, HAT_COUNT, GLFW_HAT_UP);
+    check_error(GLFW_INVALID_VALUE, "setting a hat out of range");
+    check(last.count == 0, "hat callback is not called for invalid hats");
+}
+
+static void test_gamepad(int jid)
+{
+    GLFWgamepadstate state;
+    const char* name;
+
+    check(glfwJoystickIsGamepad(jid), "joystick has a gamepad mapping");
+
+    name = glfwGetGamepadName(jid);
+    check(name && strcmp(name, "Virtual Gamepad") == 0, "gamepad name");
+
+    check(glfwGetGamepadState(jid, &state), "gamepad state is available");
+
+    check(state.buttons[GLFW_GAMEPAD_BUTTON_A] == GLFW_PRESS &&
+          state.buttons[GLFW_GAMEPAD_BUTTON_B] == GLFW_RELEASE,
+          "gamepad buttons follow joystick buttons");
+
+    check(state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_UP] == GLFW_PRESS &&
+          state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_RIGHT] == GLFW_RELEASE &&
+          state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_DOWN] == GLFW_RELEASE &&
+          state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_LEFT] == GLFW_PRESS,
+          "gamepad directional pad follows the hat");
+
+    check(state.buttons[GLFW_GAMEPAD_BUTTON_GUIDE] == GLFW_PRESS,
+          "hat element with a mask is pressed by any of its bits");
+
+    check(state.axes[GLFW_GAMEPAD_AXIS_LEFT_X] == 0.f &&
+          state.axes[GLFW_GAMEPAD_AXIS_LEFT_Y] == -0.5f &&
+          state.axes[GLFW_GAMEPAD_AXIS_RIGHT_X] == 1.f,
+          "gamepad axes follow joystick axes");
+
+    glfwSetVirtualJoystickHat(jid, 0, GLFW_HAT_DOWN);
+    glfwSetVirtualJoystickButton(jid, 0, GLFW_RELEASE);
+
+    check(glfwGetGamepadState(jid, &state), "gamepad state is still available");
+    check(state.buttons[GLFW_GAMEPAD_BUTTON_A] == GLFW_RELEASE &&
+          state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_UP] == GLFW_RELEASE &&
+          state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_DOWN] == GLFW_PRESS &&
+          state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_LEFT] == GLFW_RELEASE &&
+          state.buttons[GLFW_GAMEPAD_BUTTON_GUIDE] == GLFW_PRESS,
+          "gamepad state follows later changes");
+
+    glfwSetVirtualJoystickHat(jid, 0, GLFW_HAT_RIGHT_UP);
+
+    check(glfwGetGamepadState(jid, &state), "gamepad state is still available");
+    check(state.buttons[GLFW_GAMEPAD_BUTTON_GUIDE] == GLFW_RELEASE,
+          "hat element with a mask is released without any of its bits");
+
+    check_error(GLFW_NO_ERROR, "querying the gamepad state");
+}
+
+int main(void)
+{
+    int jid;
+
+    if (!glfwInit())
+    {
+        printf("Failed to initialize GLFW, skipping test\n");
+        exit(77);
+    }
+
+    glfwSetJoystickCallback(joystick_callback);
+    glfwSetJoystickAxisCallback(axis_callback);
+    glfwSetJoystickButtonCallback(button_callback);
+    glfwSetJoystickHatCallback(hat_callback);
+
+    check(glfwUpdateGamepadMappings(mapping), "mapping is accepted");
+    check_error(GLFW_NO_ERROR, "adding the gamepad mapping");
+
+    reset_events();
+    jid = glfwCreateVirtualJoystick(TEST_NAME, TEST_GUID,
+                                    AXIS_COUNT, BUTTON_COUNT, HAT_COUNT);
+    if (jid == -1)
+    {
+        printf("Failed to create virtual joystick\n");
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    check(last.count == 1 && last.jid == jid && last.event == GLFW_CONNECTED,
+          "joystick callback reports the connection");
+
+    test_initial_state(jid);
+    test_axes(jid);
+    test_buttons(jid);
+    test_hats(jid);
+    test_gamepad(jid);
+
+    reset_events();
+    glfwDestroyVirtualJoystick(jid);
+    check(last.count == 1 && last.jid == jid &&
+          last.event == GLFW_DISCONNECTED,
+          "joystick callback reports the disconnection");
+    check(!glfwJoystickPresent(jid), "joystick is no longer present");
+    check_error(GLFW_NO_ERROR, "destroying the joystick");
+
+    glfwSetVirtualJoystickAxis(jid, 0, 0.f);
+    check_error(GLFW_INVALID_VALUE, "using a destroyed joystick");
+
+    glfwTerminate();
+
+    if (errors)
+    {
+        printf("%i virtual joystick checks failed\n", errors);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("All virtual joystick checks passed\n");
+    exit(EXIT_SUCCESS);
+}
+